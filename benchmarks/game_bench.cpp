@@ -0,0 +1,56 @@
+#include "game.h"
+#include "grid_size.h"
+#include "random.h"
+
+#include <benchmark/benchmark.h>
+
+
+namespace {
+
+/**
+ * @brief A full drop cycle of a headless game.
+ *
+ * @details
+ * Each iteration shifts the current tetromino randomly,
+ * then ticks until it is fixed and the next tetromino is pushed.
+ * The game restarts outside the measurement when it is over.
+ */
+void BM_GameDropCycle(benchmark::State& state) {
+    const auto width {GetWidth(state)};
+    GameSettings settings;
+    settings.SetHeadless(true).SetSeed(0).SetRandomizer(Randomizer::Bag7);
+    Game game {std::make_shared<Grid>(width, GetHeight(state)), settings};
+    game.Start();
+
+    Xoshiro256 eng {0};
+    std::size_t tick_count {0};
+    for (auto _ : state) {
+        const auto target {eng.Below(width)}, center {width / 2};
+        const auto action {target < center ? Action::MoveToLeft
+                                           : Action::MoveToRight};
+        for (auto i {target < center ? center - target : target - center};
+             i > 0; --i) {
+            game.Act(action);
+        }
+
+        auto result {ActionResult::Succeeded};
+        do {
+            result = game.Tick();
+            ++tick_count;
+        } while (result == ActionResult::Succeeded);
+
+        if (result == ActionResult::GameOver) {
+            state.PauseTiming();
+            game.Start();
+            state.ResumeTiming();
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    state.counters["ticks_per_piece"] = benchmark::Counter(
+        static_cast<double>(tick_count) / state.iterations());
+}
+
+BENCHMARK(BM_GameDropCycle)->Apply(GridSizes);
+
+}  // namespace
@@ -0,0 +1,306 @@
+#include "feature.h"
+#include "grid.h"
+#include "grid_size.h"
+#include "random.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cassert>
+#include <optional>
+#include <vector>
+
+
+namespace {
+
+using tetromino::Type;
+
+/**
+ * @brief The number of grids prepared at a time for benchmarks changing them.
+ *
+ * @details
+ * Pausing the timer costs about as much as a change,
+ * so grids are prepared in batches with the timer paused once per batch.
+ */
+constexpr std::size_t batch_size {64};
+
+/**
+ * @brief Drop a tetromino from the top of a column until it is fixed.
+ *
+ * @return The number of cleared lines, or @p std::nullopt if the tetromino cannot be pushed.
+ */
+std::optional<std::size_t> Drop(Grid& grid, const Type type, const Angle angle,
+                                const std::size_t x) noexcept {
+    if (!grid.PushTetromino(Piece {type, angle}, Point {x, 0})) {
+        return std::nullopt;
+    }
+
+    std::size_t cleared_line_count {0};
+    while (grid.TetrominoDescend(cleared_line_count)) {
+    }
+
+    return cleared_line_count;
+}
+
+//! Get the lowest row where a tetromino dropped from the top of a column rests.
+std::size_t GetLandingRow(const Grid& grid, const Type type, const Angle angle,
+                          const std::size_t x) noexcept {
+    std::size_t y {0};
+    while (grid.CanPlace(type, angle, {x, y + 1})) {
+        ++y;
+    }
+
+    return y;
+}
+
+//! Create a grid whose lower half is filled by randomly dropped tetrominoes, stopping at the middle row.
+Grid MakeStack(const std::size_t width, const std::size_t height) noexcept {
+    Grid grid(width, height);
+    Xoshiro256 eng {0};
+    const auto piece_count {width * height / 2 / tetromino::cell_count};
+    for (std::size_t i {0}; i < piece_count; ++i) {
+        const auto type {static_cast<Type>(eng.Below(tetromino::type_count))};
+        const auto angle {static_cast<Angle>(eng.Below(4))};
+        const auto x {eng.Below(
+            width - tetromino::GetShapeMask(type, angle).width + 1)};
+        if (GetLandingRow(grid, type, angle, x) < height / 2) {
+            break;
+        }
+
+        Drop(grid, type, angle, x);
+    }
+
+    return grid;
+}
+
+/**
+ * @brief A grid where dropping a tetromino clears a number of lines.
+ *
+ * @details
+ * The bottom 4 rows are filled by O tetrominoes except the first 2 columns.
+ * Up to one more tetromino is fixed in those columns,
+ * and then dropping the final tetromino into them clears 1 to 4 lines.
+ */
+struct LineClearSetup {
+    LineClearSetup(const std::size_t width, const std::size_t height,
+                   const std::size_t line_count) noexcept :
+        grid(width, height) {
+        for (std::size_t layer {0}; layer < 2; ++layer) {
+            for (std::size_t x {2}; x < width; x += 2) {
+                Drop(grid, Type::O, Angle::Degree0, x);
+            }
+        }
+
+        switch (line_count) {
+            case 1: {
+                final_piece = {Type::J, Angle::Degree0};
+                break;
+            }
+            case 2: {
+                final_piece = {Type::O, Angle::Degree0};
+                break;
+            }
+            case 3: {
+                Drop(grid, Type::J, Angle::Degree0, 0);
+                final_piece = {Type::J, Angle::Degree180};
+                break;
+            }
+            case 4: {
+                Drop(grid, Type::I, Angle::Degree0, 0);
+                final_piece = {Type::I, Angle::Degree0};
+                final_pos.x = 1;
+                break;
+            }
+            default: {
+                assert(false);
+            }
+        }
+
+        final_pos.y = GetLandingRow(grid, final_piece.GetType(),
+                                    final_piece.GetAngle(), final_pos.x);
+    }
+
+    Grid grid;
+
+    Piece final_piece;
+
+    Point final_pos;
+};
+
+void BM_CanPlace(benchmark::State& state) {
+    const auto width {GetWidth(state)}, height {GetHeight(state)};
+    const auto grid {MakeStack(width, height)};
+
+    struct Placement {
+        Type type;
+        Angle angle;
+        Point pos;
+    };
+
+    constexpr std::size_t placement_count {1024};
+    std::vector<Placement> placements;
+    placements.reserve(placement_count);
+    Xoshiro256 eng {1};
+    for (std::size_t i {0}; i < placement_count; ++i) {
+        const auto type {static_cast<Type>(eng.Below(tetromino::type_count))};
+        const auto angle {static_cast<Angle>(eng.Below(4))};
+        placements.push_back(
+            {type, angle, {eng.Below(width), eng.Below(height)}});
+    }
+
+    std::size_t i {0};
+    for (auto _ : state) {
+        const auto& placement {placements[i++ % placement_count]};
+        benchmark::DoNotOptimize(
+            grid.CanPlace(placement.type, placement.angle, placement.pos));
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_CanPlace)->Apply(GridSizes);
+
+void BM_ClearLines(benchmark::State& state) {
+    const auto line_count {static_cast<std::size_t>(state.range(2))};
+    const LineClearSetup setup {GetWidth(state), GetHeight(state), line_count};
+    std::vector<Grid> grids;
+    while (state.KeepRunningBatch(batch_size)) {
+        state.PauseTiming();
+        grids.assign(batch_size, setup.grid);
+        state.ResumeTiming();
+
+        for (auto& grid : grids) {
+            grid.PushTetromino(setup.final_piece, setup.final_pos);
+            std::size_t cleared_line_count {0};
+            grid.TetrominoDescend(cleared_line_count);
+            if (cleared_line_count != line_count) {
+                state.SkipWithError("Unexpected number of cleared lines");
+                break;
+            }
+
+            benchmark::DoNotOptimize(grid);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * line_count);
+}
+
+BENCHMARK(BM_ClearLines)->Apply([](benchmark::internal::Benchmark* const bench) {
+    bench->ArgNames({"width", "height", "lines"});
+    for (const auto& [width, height] : grid_sizes) {
+        for (std::int64_t lines {1}; lines <= 4; ++lines) {
+            bench->Args({width, height, lines});
+        }
+    }
+});
+
+void BM_FixTetromino(benchmark::State& state) {
+    const auto height {GetHeight(state)};
+    std::vector<Grid> grids(batch_size, Grid(GetWidth(state), height));
+    const Point pos {0, height - 2};
+    while (state.KeepRunningBatch(batch_size)) {
+        state.PauseTiming();
+        for (auto& grid : grids) {
+            grid.Reset();
+        }
+
+        state.ResumeTiming();
+
+        for (auto& grid : grids) {
+            grid.PushTetromino(Piece {Type::O}, pos);
+            std::size_t cleared_line_count {0};
+            benchmark::DoNotOptimize(
+                grid.TetrominoDescend(cleared_line_count));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_FixTetromino)->Apply(GridSizes);
+
+void BM_MoveAndRotate(benchmark::State& state) {
+    auto grid {MakeStack(GetWidth(state), GetHeight(state))};
+    grid.PushTetromino(Piece {Type::T});
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(grid.MoveTetrominoToLeft());
+        benchmark::DoNotOptimize(grid.RotateTetrominoLeft());
+        benchmark::DoNotOptimize(grid.MoveTetrominoToRight());
+        benchmark::DoNotOptimize(grid.RotateTetrominoRight());
+    }
+
+    state.SetItemsProcessed(state.iterations() * 4);
+}
+
+BENCHMARK(BM_MoveAndRotate)->Apply(GridSizes);
+
+void BM_GetDropPosition(benchmark::State& state) {
+    auto grid {MakeStack(GetWidth(state), GetHeight(state))};
+    grid.PushTetromino(Piece {Type::T}, Point {0, 0});
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(grid.GetDropPosition());
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_GetDropPosition)->Apply(GridSizes);
+
+void BM_GetPlacements(benchmark::State& state) {
+    const auto grid {MakeStack(GetWidth(state), GetHeight(state))};
+    const Point entrance {GetWidth(state) / 2, 0};
+    std::size_t placement_count {0};
+    for (auto _ : state) {
+        const auto placements {
+            grid.GetPlacements(Type::T, Angle::Degree0, entrance)};
+        placement_count += placements.size();
+        benchmark::DoNotOptimize(placements.data());
+    }
+
+    state.SetItemsProcessed(placement_count);
+}
+
+BENCHMARK(BM_GetPlacements)->Apply(GridSizes);
+
+void BM_ForkAndDrop(benchmark::State& state) {
+    auto grid {MakeStack(GetWidth(state), GetHeight(state))};
+    grid.PushTetromino(Piece {Type::T}, Point {0, 0});
+    for (auto _ : state) {
+        auto fork {grid.Fork()};
+        std::size_t cleared_line_count {0};
+        fork.TetrominoHardDrop(cleared_line_count);
+        benchmark::DoNotOptimize(fork);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_ForkAndDrop)->Apply(GridSizes);
+
+void BM_SnapshotAndRestore(benchmark::State& state) {
+    auto grid {MakeStack(GetWidth(state), GetHeight(state))};
+    grid.PushTetromino(Piece {Type::T}, Point {0, 0});
+    const auto snapshot {grid.Snapshot()};
+    for (auto _ : state) {
+        grid.MoveTetrominoToRight();
+        grid.Restore(snapshot);
+        benchmark::DoNotOptimize(grid);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_SnapshotAndRestore)->Apply(GridSizes);
+
+void BM_ExtractFeatures(benchmark::State& state) {
+    const auto grid {MakeStack(GetWidth(state), GetHeight(state))};
+    FeatureExtractor extractor;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(extractor.Extract(grid));
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_ExtractFeatures)->Apply(GridSizes);
+
+}  // namespace
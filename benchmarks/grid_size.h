@@ -0,0 +1,46 @@
+/**
+ * @file grid_size.h
+ * @brief Grid sizes shared by benchmarks.
+ *
+ * @author Chen Zhenshuo (chenzs108@outlook.com)
+ * @par GitHub
+ * https://github.com/Zhuagenborn
+ * @version 1.0
+ * @date 2023-05-06
+ */
+
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstdint>
+#include <utility>
+
+
+//! Grid sizes from 10x20 to 64x1024. All widths are even.
+inline constexpr std::array<std::pair<std::int64_t, std::int64_t>, 4> grid_sizes {
+    {{10, 20}, {16, 64}, {32, 256}, {64, 1024}}};
+
+/**
+ * @brief Parameterize a benchmark over @p grid_sizes.
+ *
+ * @details
+ * The first argument is the width and the second one is the height.
+ */
+inline void GridSizes(benchmark::internal::Benchmark* const bench) noexcept {
+    bench->ArgNames({"width", "height"});
+    for (const auto& [width, height] : grid_sizes) {
+        bench->Args({width, height});
+    }
+}
+
+//! Get the grid width of a benchmark parameterized by @p GridSizes.
+inline std::size_t GetWidth(const benchmark::State& state) noexcept {
+    return static_cast<std::size_t>(state.range(0));
+}
+
+//! Get the grid height of a benchmark parameterized by @p GridSizes.
+inline std::size_t GetHeight(const benchmark::State& state) noexcept {
+    return static_cast<std::size_t>(state.range(1));
+}
\ No newline at end of file
@@ -0,0 +1,122 @@
+#include "row_scan.h"
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <optional>
+#include <span>
+#include <vector>
+
+
+namespace {
+
+using namespace row_scan;
+
+constexpr std::array kernels {Kernel::Portable, Kernel::AVX2};
+
+//! Parameterize a benchmark over row widths from 64 to 4096 columns.
+void Widths(benchmark::internal::Benchmark* const bench) noexcept {
+    bench->ArgName("width")->RangeMultiplier(4)->Range(64, 4096);
+}
+
+//! Test each cell of a row, as grids did before they were packed into words.
+bool AllCells(const std::span<const Word> words, const std::size_t width,
+              const bool filled) noexcept {
+    for (std::size_t x {0}; x < width; ++x) {
+        if (static_cast<bool>((words[x / 64] >> (x % 64)) & 1) != filled) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//! Parameterize a benchmark over kernels and row widths from 64 to 4096 columns.
+void KernelsAndWidths(benchmark::internal::Benchmark* const bench) noexcept {
+    bench->ArgNames({"kernel", "width"});
+    for (std::size_t kernel {0}; kernel < kernels.size(); ++kernel) {
+        for (std::int64_t width {64}; width <= 4096; width *= 4) {
+            bench->Args({static_cast<std::int64_t>(kernel), width});
+        }
+    }
+}
+
+/**
+ * @brief Get the kernel of a benchmark parameterized by @p KernelsAndWidths.
+ *
+ * @return The kernel, or @p std::nullopt if it is not supported and the benchmark is skipped.
+ */
+std::optional<Kernel> GetKernel(benchmark::State& state) noexcept {
+    const auto kernel {kernels[static_cast<std::size_t>(state.range(0))]};
+    if (IsSupported(kernel)) {
+        state.SetLabel(to_string(kernel));
+        return kernel;
+    } else {
+        state.SkipWithError("The kernel is not supported");
+        return std::nullopt;
+    }
+}
+
+//! Test each cell of full rows as a baseline.
+void BM_AllSetPerCell(benchmark::State& state) {
+    const auto width {static_cast<std::size_t>(state.range(0))};
+    const std::vector<Word> row(width / 64, ~Word {0});
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(AllCells(row, width, true));
+    }
+
+    state.SetItemsProcessed(state.iterations() * width);
+}
+
+BENCHMARK(BM_AllSetPerCell)->Apply(Widths);
+
+//! Scan full rows, which must read every word.
+void BM_AllSet(benchmark::State& state) {
+    const auto kernel {GetKernel(state)};
+    const auto width {static_cast<std::size_t>(state.range(1))};
+    const std::vector<Word> row(width / 64, ~Word {0});
+    for (auto _ : state) {
+        if (!kernel.has_value()) {
+            break;
+        }
+
+        benchmark::DoNotOptimize(AllSet(kernel.value(), row, ~Word {0}));
+    }
+
+    state.SetItemsProcessed(state.iterations() * width);
+}
+
+BENCHMARK(BM_AllSet)->Apply(KernelsAndWidths);
+
+//! Test each cell of empty rows as a baseline.
+void BM_AllClearPerCell(benchmark::State& state) {
+    const auto width {static_cast<std::size_t>(state.range(0))};
+    const std::vector<Word> row(width / 64, 0);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(AllCells(row, width, false));
+    }
+
+    state.SetItemsProcessed(state.iterations() * width);
+}
+
+BENCHMARK(BM_AllClearPerCell)->Apply(Widths);
+
+//! Scan empty rows, which must read every word.
+void BM_AllClear(benchmark::State& state) {
+    const auto kernel {GetKernel(state)};
+    const auto width {static_cast<std::size_t>(state.range(1))};
+    const std::vector<Word> row(width / 64, 0);
+    for (auto _ : state) {
+        if (!kernel.has_value()) {
+            break;
+        }
+
+        benchmark::DoNotOptimize(AllClear(kernel.value(), row));
+    }
+
+    state.SetItemsProcessed(state.iterations() * width);
+}
+
+BENCHMARK(BM_AllClear)->Apply(KernelsAndWidths);
+
+}  // namespace
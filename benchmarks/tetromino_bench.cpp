@@ -0,0 +1,25 @@
+#include "tetromino.h"
+
+#include <benchmark/benchmark.h>
+
+
+namespace {
+
+void BM_GetRandomType(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(tetromino::GetRandomType());
+    }
+}
+
+BENCHMARK(BM_GetRandomType);
+
+void BM_CreateTetromino(benchmark::State& state) {
+    for (auto _ : state) {
+        auto tetromino {tetromino::Create(tetromino::GetRandomType())};
+        benchmark::DoNotOptimize(tetromino);
+    }
+}
+
+BENCHMARK(BM_CreateTetromino);
+
+}  // namespace
@@ -11,7 +11,9 @@
 
 #pragma once
 
+#include <cstdint>
 #include <memory>
+#include <string>
 
 /**
  * @brief A command line argument handler.
@@ -22,7 +24,26 @@
  * ```bash
  * -x=<width>
  * -y=<height>
+ * -games=<count>
+ * -threads=<count>
+ * -seed=<seed>
+ * -scaling
+ * -record=<path>
+ * -replay=<path>
+ * -ai
+ * -headless
+ * -next=<count>
+ * -beam=<width>
+ * -budget=<milliseconds>
+ * -pieces=<count>
+ * -latency=<path>
  * ```
+ *
+ * @p -games, @p -scaling and @p -replay are only used by the simulator.
+ * @p -record, @p -headless and @p -latency are only used by the game.
+ * @p -pieces is used by the game only when it runs headlessly.
+ * @p -seed is used by the game only when the autoplayer plays.
+ * The game uses @p -threads for the beam search.
  */
 class CmdArgs {
 public:
@@ -34,6 +55,44 @@ public:
 
     std::size_t GetHeight() const noexcept;
 
+    //! Get the number of games to simulate.
+    std::size_t GetGameCount() const noexcept;
+
+    //! Get the number of threads. @p 0 means the number of hardware threads.
+    std::size_t GetThreadCount() const noexcept;
+
+    std::uint64_t GetSeed() const noexcept;
+
+    //! Whether to measure how throughput scales with the number of threads.
+    bool IsScaling() const noexcept;
+
+    //! Get the path of the replay to record. An empty path means no recording.
+    std::string GetRecordPath() const noexcept;
+
+    //! Get the path of the replay to play. An empty path means no replay.
+    std::string GetReplayPath() const noexcept;
+
+    //! Whether the built-in heuristic policy plays instead of the user or random actions.
+    bool IsAutoplay() const noexcept;
+
+    //! Whether the autoplayer plays as fast as possible without the user interface.
+    bool IsHeadless() const noexcept;
+
+    //! Get the number of next tetrominoes. @p 0 means the default.
+    std::size_t GetNextCount() const noexcept;
+
+    //! Get the beam width of the autoplayer. @p 0 means no beam search.
+    std::size_t GetBeamWidth() const noexcept;
+
+    //! Get the planning time budget per tetromino in milliseconds. @p 0 means no budget.
+    std::size_t GetBudget() const noexcept;
+
+    //! Get the number of tetrominoes the headless autoplayer places. @p 0 means playing until the game is over.
+    std::size_t GetPieceCount() const noexcept;
+
+    //! Get the path to write latency percentiles of the user interface to. An empty path means no report.
+    std::string GetLatencyPath() const noexcept;
+
     ~CmdArgs() noexcept;
 
 private:
@@ -12,6 +12,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <iostream>
 #include <string>
 
@@ -22,7 +23,16 @@
  * The developer must place @p Non first and @p White last.
  * They are used to count the number of colors.
  */
-enum class Color { Non, Red, Green, Blue, Yellow, Magenta, Cyan, White };
+enum class Color : std::uint8_t {
+    Non,
+    Red,
+    Green,
+    Blue,
+    Yellow,
+    Magenta,
+    Cyan,
+    White
+};
 
 std::string to_string(Color) noexcept;
 
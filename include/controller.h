@@ -12,8 +12,10 @@
 #pragma once
 
 #include "game.h"
+#include "policy.h"
 
 #include <memory>
+#include <ostream>
 
 
 class Controller {
@@ -27,12 +29,27 @@ public:
         ~Initializer() noexcept;
     };
 
-    Controller(std::unique_ptr<Game>) noexcept;
+    /**
+     * @param game A started game.
+     * @param player
+     * A policy playing instead of the user, or @p nullptr.
+     * It acts several times per descent, so the game can be watched.
+     *
+     * @note
+     * A headless game is driven by @p Update instead of a game loop thread.
+     */
+    Controller(std::unique_ptr<Game> game,
+               std::unique_ptr<Policy> player = nullptr) noexcept;
 
-    //! Get a user's input.
+    //! Get a user's input, or the action chosen by the player.
     void Input() noexcept;
 
-    //! Update the game.
+    /**
+     * @brief Post the action to the game loop.
+     *
+     * @details
+     * A headless game executes the action immediately and is descended when its descent time has passed.
+     */
     void Update() noexcept;
 
     //! Refresh graphics.
@@ -40,6 +57,16 @@ public:
 
     bool IsOver() const noexcept;
 
+    /**
+     * @brief Print the percentiles of input latency and frame time.
+     *
+     * @details
+     * - Input to action: From receiving a key to executing or posting its action.
+     * - Input to frame: From receiving a key to refreshing the first frame showing its action.
+     * - Frame time: The time of drawing and refreshing all boards.
+     */
+    void PrintLatency(std::ostream&) const noexcept;
+
     ~Controller() noexcept;
 
 private:
@@ -0,0 +1,157 @@
+/**
+ * @file feature.h
+ * @brief Board features for evaluating placements.
+ *
+ * @author Chen Zhenshuo (chenzs108@outlook.com)
+ * @par GitHub
+ * https://github.com/Zhuagenborn
+ * @version 1.0
+ * @date 2023-05-08
+ */
+
+#pragma once
+
+#include "grid.h"
+#include "piece.h"
+
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <vector>
+
+
+//! Classic features of the fixed tetrominoes in a grid.
+struct BoardFeatures {
+    //! The sum of column heights.
+    std::size_t aggregate_height;
+
+    //! The highest column height.
+    std::size_t max_height;
+
+    //! The number of empty cells below the top of their columns.
+    std::size_t holes;
+
+    //! The sum of height differences between adjacent columns.
+    std::size_t bumpiness;
+
+    /**
+     * @brief The number of horizontal changes between filled and empty cells.
+     *
+     * @details
+     * Both walls count as filled.
+     */
+    std::size_t row_transitions;
+
+    /**
+     * @brief The number of vertical changes between filled and empty cells.
+     *
+     * @details
+     * The floor counts as filled and the space above the grid as empty.
+     */
+    std::size_t column_transitions;
+
+    /**
+     * @brief The sum of well depths.
+     *
+     * @details
+     * A well is a column of empty cells above its column top whose neighbors are both filled or walls.
+     * A well of depth @p n contributes <tt>1 + 2 + ... + n</tt>.
+     */
+    std::size_t wells;
+
+    //! The number of full lines.
+    std::size_t completed_lines;
+
+    constexpr bool operator==(const BoardFeatures&) const noexcept = default;
+};
+
+/**
+ * @brief Weights of board features. A positive weight rewards a feature.
+ *
+ * @details
+ * The defaults are weights tuned by a genetic algorithm for a 10x20 grid.
+ */
+struct FeatureWeights {
+    double aggregate_height {-0.510066};
+
+    double max_height {0};
+
+    double holes {-0.35663};
+
+    double bumpiness {-0.184483};
+
+    double row_transitions {0};
+
+    double column_transitions {0};
+
+    double wells {0};
+
+    double completed_lines {0.760666};
+};
+
+//! Get the weighted sum of board features.
+double Evaluate(const BoardFeatures&, const FeatureWeights& = {}) noexcept;
+
+/**
+ * @brief An extractor computing board features in a single pass over row bitmasks.
+ *
+ * @details
+ * It reuses its buffers between calls, so a search thread should keep its own extractor.
+ */
+class FeatureExtractor {
+public:
+    /**
+     * @brief Extract the features of a grid.
+     *
+     * @param grid A grid. Its current tetromino is ignored.
+     * @param placed
+     * A piece that has been placed but not fixed yet.
+     * It is counted as fixed and the lines it completes are not cleared.
+     */
+    BoardFeatures Extract(const Grid& grid,
+                          std::optional<Piece> placed = std::nullopt) noexcept;
+
+    /**
+     * @brief Extract the features of many candidate grids.
+     *
+     * @details
+     * It is a convenience wrapper extracting each grid in turn.
+     * The buffers are allocated once for the batch, but no other work is shared between grids.
+     *
+     * @param grids Grids.
+     * @param[out] features The features of each grid. Its size must be the same as @p grids.
+     */
+    void Extract(std::span<const Grid> grids,
+                 std::span<BoardFeatures> features) noexcept;
+
+    //! Extract the features of many candidate grids into a new vector.
+    std::vector<BoardFeatures> Extract(std::span<const Grid> grids) noexcept;
+
+private:
+    using RowMask = Grid::RowMask;
+
+    //! Get a row with the placed piece merged.
+    std::span<const RowMask> GetRow(
+        const Grid& grid, std::size_t y,
+        const std::optional<Piece>& placed) noexcept;
+
+    //! Columns having a filled cell in the rows scanned so far.
+    std::vector<RowMask> covered_;
+
+    //! The last scanned row.
+    std::vector<RowMask> above_;
+
+    //! Columns whose last scanned cell is part of a well.
+    std::vector<RowMask> in_wells_;
+
+    //! A copy of a row for merging the placed piece.
+    std::vector<RowMask> merged_;
+
+    std::vector<std::size_t> heights_;
+
+    std::vector<std::size_t> well_depths_;
+};
+
+//! Extract the features of a grid with a temporary extractor.
+BoardFeatures ExtractFeatures(
+    const Grid& grid, std::optional<Piece> placed = std::nullopt) noexcept;
\ No newline at end of file
@@ -12,22 +12,36 @@
 
 #pragma once
 
+#include "generator.h"
 #include "grid.h"
+#include "mpsc_queue.h"
+#include "notifier.h"
 
+#include <atomic>
 #include <chrono>
-#include <deque>
+#include <cstdint>
+#include <functional>
+#include <limits>
 #include <memory>
-#include <mutex>
+#include <optional>
+#include <span>
+#include <stop_token>
 #include <thread>
+#include <vector>
 
 
+class GravityScheduler;
+
 enum class Action {
     Non,
     MoveToLeft,
     MoveToRight,
     RotateLeft,
     RotateRight,
-    Descend
+    Descend,
+
+    //! Drop the current tetromino straight down and fix it.
+    HardDrop
 };
 
 enum class ActionResult {
@@ -46,16 +60,78 @@ enum class ActionResult {
 
 class GameSettings {
 public:
-    //! Set the number of next tetrominoes. The minimum is 1.
+    //! The maximum number of next tetrominoes.
+    static constexpr std::size_t max_next_count {
+        PieceQueue::capacity - PieceGenerator::max_batch_size - 1};
+
+    //! Set the number of next tetrominoes. The minimum is 1 and the maximum is @p max_next_count.
     GameSettings& SetNextCount(std::size_t) noexcept;
 
-    //! Set the descent rate.
+    //! Set the initial descent rate.
     GameSettings& SetDescendTime(std::chrono::steady_clock::duration) noexcept;
 
+    /**
+     * @brief Set whether the game runs headlessly.
+     *
+     * @details
+     * A headless game has no game loop thread and never sleeps or synchronizes.
+     * The caller advances gravity by @p Game::Tick and actions by @p Game::Act from a single thread.
+     */
+    GameSettings& SetHeadless(bool) noexcept;
+
+    /**
+     * @brief Set the seed of the tetromino sequence.
+     *
+     * @details
+     * The same seed reproduces the same sequence.
+     * Without a seed, a nondeterministic one is chosen each time a game starts.
+     */
+    GameSettings& SetSeed(std::uint64_t) noexcept;
+
+    /**
+     * @brief Set a scheduler running the game loop instead of a thread of the game.
+     *
+     * @details
+     * It is ignored by headless games.
+     * If the scheduler is full when the game starts, the game creates its own thread.
+     */
+    GameSettings& SetScheduler(std::shared_ptr<GravityScheduler>) noexcept;
+
+    //! Select a built-in randomizer strategy. The default is @p Randomizer::Uniform.
+    GameSettings& SetRandomizer(Randomizer) noexcept;
+
+    /**
+     * @brief Set a factory creating a custom tetromino generator for each game.
+     *
+     * @details
+     * The randomizer strategy becomes @p Randomizer::Custom.
+     */
+    GameSettings& SetGenerator(PieceGeneratorFactory) noexcept;
+
     constexpr std::size_t GetNextCount() const noexcept {
         return next_count_;
     }
 
+    constexpr bool IsHeadless() const noexcept {
+        return headless_;
+    }
+
+    constexpr std::optional<std::uint64_t> GetSeed() const noexcept {
+        return seed_;
+    }
+
+    constexpr Randomizer GetRandomizer() const noexcept {
+        return randomizer_;
+    }
+
+    const PieceGeneratorFactory& GetGenerator() const noexcept {
+        return generator_;
+    }
+
+    const std::shared_ptr<GravityScheduler>& GetScheduler() const noexcept {
+        return scheduler_;
+    }
+
     constexpr std::chrono::steady_clock::duration GetDescendTime()
         const noexcept {
         return descend_time_;
@@ -66,30 +142,182 @@ private:
 
     std::chrono::steady_clock::duration descend_time_ {
         std::chrono::seconds {1}};
+
+    bool headless_ {false};
+
+    std::optional<std::uint64_t> seed_;
+
+    std::shared_ptr<GravityScheduler> scheduler_;
+
+    Randomizer randomizer_ {Randomizer::Uniform};
+
+    PieceGeneratorFactory generator_ {[](const std::uint64_t seed) {
+        return CreateGenerator(Randomizer::Uniform, seed);
+    }};
 };
 
+//! An immutable snapshot of a game.
+struct GameState {
+    //! A fork of the grid sharing its cells until the game changes them.
+    Grid grid;
+
+    std::vector<Piece> next_tetrominoes;
+
+    std::size_t score {0};
+
+    std::size_t line_count {0};
+
+    std::size_t tick_count {0};
+
+    std::size_t piece_count {0};
+
+    //! The number of executed actions other than @p Action::Non.
+    std::size_t action_count {0};
+
+    bool over {false};
+};
+
+/**
+ * @brief A game.
+ *
+ * @details
+ * A game that is not headless is owned by its game loop thread,
+ * which is the only one changing it.
+ * The thread is either created by the game or shared with other games by a @p GravityScheduler.
+ * Other threads post actions into a lock-free queue, and the loop executes them in order between gravity ticks.
+ * Posting never waits for the loop to finish its work. A lock is only taken briefly to wake up a sleeping loop.
+ * After each change, the loop publishes a new @p GameState that readers load atomically,
+ * so they never see a partially updated game or race with an action.
+ */
 class Game {
 public:
+    //! The number of actions that can wait in the queue.
+    static constexpr std::size_t action_queue_capacity {64};
+
+    /**
+     * @brief A listener called before each action passed to @p Act or @p Post is executed.
+     *
+     * @param tick The number of elapsed gravity ticks.
+     * @param action An action other than @p Action::Non.
+     */
+    using ActionListener = std::function<void(std::size_t tick, Action)>;
+
     Game(std::shared_ptr<Grid>, GameSettings) noexcept;
 
+    /**
+     * @brief Start the game, or restart it if it has been started.
+     *
+     * @details
+     * If the game is not headless, a game loop will be run
+     * to execute posted actions and descend the current tetromino periodically.
+     * Actions posted before are discarded.
+     */
     void Start() noexcept;
 
+    /**
+     * @brief Stop the game immediately, making it over.
+     *
+     * @details
+     * The game loop is woken up and stopped without waiting for the next descent.
+     * When it returns, the game loop no longer runs, and the game can be started again.
+     *
+     * @warning
+     * It must not be called from the game loop, e.g. by the action listener.
+     */
+    void Stop() noexcept;
+
+    /**
+     * @brief Execute an action immediately.
+     *
+     * @warning
+     * It should only be used for headless games.
+     */
     ActionResult Act(Action) noexcept;
 
+    /**
+     * @brief Post an action to the game loop. It can be called from any thread.
+     *
+     * @details
+     * It never waits for the game loop to finish its work.
+     * If the loop is sleeping, a lock is taken briefly to wake it up.
+     *
+     * @return Whether the action has been queued. It fails if the queue is full.
+     *
+     * @warning
+     * It should only be used for games that are not headless.
+     */
+    bool Post(Action) noexcept;
+
+    /**
+     * @brief Set or remove the action listener.
+     *
+     * @details
+     * If the game is not headless, the game loop takes over the listener before executing the next action.
+     */
+    void SetActionListener(ActionListener) noexcept;
+
+    /**
+     * @brief Advance gravity by one tick, descending the current tetromino by 1 cell.
+     *
+     * @warning
+     * It should only be used for headless games, which are only descended by calling this method.
+     */
+    ActionResult Tick() noexcept;
+
+    /**
+     * @brief Get a snapshot of the game.
+     *
+     * @details
+     * For a game that is not headless, it is the latest one published by the game loop.
+     * For a headless game, a new one is taken.
+     */
+    std::shared_ptr<const GameState> GetState() const noexcept;
+
+    /**
+     * @brief Change the descent rate, e.g. when the level changes. It can be called from any thread.
+     *
+     * @details
+     * The next descent is rescheduled relative to the last one.
+     */
+    void SetDescendTime(std::chrono::steady_clock::duration) noexcept;
+
+    std::chrono::steady_clock::duration GetDescendTime() const noexcept;
+
     std::size_t GetScore() const noexcept;
 
+    //! Get the number of cleared lines.
+    std::size_t GetLineCount() const noexcept;
+
+    //! Get the seed of the tetromino sequence since the game started.
+    std::uint64_t GetSeed() const noexcept;
+
+    //! Get the number of elapsed gravity ticks.
+    std::size_t GetTickCount() const noexcept;
+
+    //! Get the number of tetrominoes that have been pushed into the grid.
+    std::size_t GetPieceCount() const noexcept;
+
     bool IsOver() const noexcept;
 
+    //! Get copies of the next tetrominoes.
+    std::vector<Piece> GetNextTetrominoes() const noexcept;
+
     /**
-     * @brief Get the next tetrominoes.
+     * @brief View the next tetrominoes in place without copying.
      *
      * @warning
-     * When each time @p Action::Descend is executed and @p ActionResult::TetrominoFixed is returned,
-     * the previous return value is longer be valid.
+     * It should only be used for headless games.
+     * The view is invalidated once a new tetromino is pushed.
      */
-    std::vector<std::reference_wrapper<const Tetromino>> GetNextTetrominoes()
-        const noexcept;
+    std::span<const Piece> PeekNextTetrominoes() const noexcept;
 
+    /**
+     * @brief Get the grid.
+     *
+     * @warning
+     * The game loop of a game that is not headless changes the grid concurrently.
+     * Other threads should read the grid of @p GetState instead.
+     */
     std::shared_ptr<const Grid> GetGrid() const noexcept;
 
     const GameSettings& GetSettings() const noexcept;
@@ -97,20 +325,107 @@ public:
     ~Game() noexcept;
 
 private:
-    void GenerateNextTetrominoes(std::size_t) noexcept;
+    friend class GravityScheduler;
+
+    /**
+     * @brief Run the game loop in the thread of the game until the game is over or stopped.
+     *
+     * @details
+     * It waits until an action is posted, the next descent is due or a stop is requested.
+     */
+    void Loop(std::stop_token) noexcept;
+
+    //! Stop the game loop and take over the game in the calling thread.
+    void StopLoop() noexcept;
+
+    /**
+     * @brief Run the game loop once, executing posted actions and the descents that are due.
+     *
+     * @details
+     * Descents are scheduled at absolute deadlines, so actions do not delay gravity.
+     *
+     * @return The time of the next descent, or @p std::nullopt if the game is over.
+     */
+    std::optional<std::chrono::steady_clock::time_point> Process(
+        std::chrono::steady_clock::time_point now) noexcept;
+
+    //! Wake up the game loop.
+    void Wake() noexcept;
+
+    //! Notify the action listener and execute an action.
+    ActionResult Execute(Action) noexcept;
+
+    //! Increase the tick count and descend the current tetromino.
+    ActionResult Descend() noexcept;
+
+    ActionResult Apply(Action) noexcept;
+
+    std::shared_ptr<const GameState> TakeState() const noexcept;
+
+    //! Publish a new snapshot for readers.
+    void Publish() noexcept;
+
+    //! Count cleared lines and push the next tetromino after the current one is fixed.
+    ActionResult OnTetrominoFixed(std::size_t cleared_line_count) noexcept;
 
     bool PushNextTetromino() noexcept;
 
-    mutable std::mutex mtx_;
+    //! A scheduler slot meaning that the game loop is not run by the scheduler.
+    static constexpr std::size_t no_slot {
+        std::numeric_limits<std::size_t>::max()};
+
+    std::jthread game_loop_;
 
-    std::unique_ptr<std::thread> descend_loop_;
+    //! The scheduler from the settings, fixed for the lifetime of the game so any thread can read it.
+    const std::shared_ptr<GravityScheduler> scheduler_;
+
+    /**
+     * @brief The slot of the game in the scheduler running its game loop, or @p no_slot.
+     *
+     * @details
+     * It is atomic since posting threads read it while the game starts or stops.
+     * A post racing with a stop may mark a slot that has been reused by another game,
+     * which only makes the scheduler run that game's loop once more.
+     */
+    std::atomic<std::size_t> scheduler_slot_ {no_slot};
+
+    MpscQueue<Action, action_queue_capacity> actions_;
+
+    //! Notified when an action is posted or the descent rate changes.
+    Notifier notifier_;
+
+    std::atomic<std::shared_ptr<const GameState>> state_;
+
+    //! A listener waiting to be taken over by the game loop.
+    std::atomic<std::shared_ptr<ActionListener>> new_action_listener_;
+
+    std::atomic<std::chrono::steady_clock::duration> descend_time_;
+
+    //! The descent rate the next descent has been scheduled with.
+    std::chrono::steady_clock::duration scheduled_descend_time_;
+
+    std::chrono::steady_clock::time_point next_descent_;
 
     std::shared_ptr<Grid> grid_;
 
-    std::deque<std::unique_ptr<Tetromino>> next_tetrominoes_;
+    std::unique_ptr<PieceGenerator> generator_;
+
+    ActionListener action_listener_;
+
+    PieceQueue next_tetrominoes_;
+
+    std::uint64_t seed_ {0};
 
     std::size_t score_ {0};
 
+    std::size_t line_count_ {0};
+
+    std::size_t tick_count_ {0};
+
+    std::size_t piece_count_ {0};
+
+    std::size_t action_count_ {0};
+
     bool running_ {false};
 
     GameSettings settings_;
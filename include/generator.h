@@ -0,0 +1,191 @@
+/**
+ * @file generator.h
+ * @brief Tetromino sequence generators.
+ *
+ * @author Chen Zhenshuo (chenzs108@outlook.com)
+ * @par GitHub
+ * https://github.com/Zhuagenborn
+ * @version 1.0
+ * @date 2023-05-05
+ */
+
+#pragma once
+
+#include "piece.h"
+#include "random.h"
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <span>
+#include <string>
+
+
+/**
+ * @brief A generator of the tetromino sequence of a game.
+ *
+ * @details
+ * Each game owns its generator, so games on different threads never share random states.
+ * A generator produces a whole batch, such as a bag, at once.
+ */
+class PieceGenerator {
+public:
+    //! The maximum number of tetrominoes in a batch.
+    static constexpr std::size_t max_batch_size {14};
+
+    using Batch = std::span<Piece, max_batch_size>;
+
+    /**
+     * @brief Generate a batch of tetrominoes.
+     *
+     * @param[out] batch The buffer receiving the tetrominoes from its beginning.
+     * @return The number of generated tetrominoes, at least 1.
+     */
+    virtual std::size_t Generate(Batch batch) noexcept = 0;
+
+    virtual ~PieceGenerator() noexcept = default;
+};
+
+//! Create a piece generator with a seed. The same seed must produce the same sequence.
+using PieceGeneratorFactory =
+    std::function<std::unique_ptr<PieceGenerator>(std::uint64_t seed)>;
+
+//! Built-in randomizer strategies.
+enum class Randomizer {
+    //! Each tetromino is chosen uniformly at random.
+    Uniform,
+
+    //! Each bag contains the 7 types once in a random order.
+    Bag7,
+
+    //! Each bag contains the 7 types twice in a random order.
+    Bag14,
+
+    //! Types in the recent history are avoided by rerolling a limited number of times.
+    History,
+
+    //! A generator provided by the developer.
+    Custom
+};
+
+std::string to_string(Randomizer) noexcept;
+
+std::ostream& operator<<(std::ostream&, Randomizer) noexcept;
+
+//! Create a generator of a built-in strategy.
+std::unique_ptr<PieceGenerator> CreateGenerator(Randomizer,
+                                                std::uint64_t seed) noexcept;
+
+//! A generator choosing types and colors uniformly at random.
+class UniformGenerator : public PieceGenerator {
+public:
+    explicit UniformGenerator(std::uint64_t seed) noexcept;
+
+    std::size_t Generate(Batch) noexcept override;
+
+private:
+    static constexpr std::size_t batch_size_ {tetromino::type_count};
+
+    Xoshiro256 eng_;
+};
+
+//! A generator shuffling bags that contain each type a fixed number of times.
+class BagGenerator : public PieceGenerator {
+public:
+    /**
+     * @param seed A seed.
+     * @param copies The number of times each type appears in a bag.
+     */
+    BagGenerator(std::uint64_t seed, std::size_t copies) noexcept;
+
+    std::size_t Generate(Batch) noexcept override;
+
+private:
+    Xoshiro256 eng_;
+
+    std::size_t bag_size_;
+};
+
+/**
+ * @brief A generator avoiding recently generated types.
+ *
+ * @details
+ * A type is rerolled while it is in the history, up to a number of times.
+ */
+class HistoryGenerator : public PieceGenerator {
+public:
+    static constexpr std::size_t history_size {4};
+
+    HistoryGenerator(std::uint64_t seed, std::size_t rerolls = 4) noexcept;
+
+    std::size_t Generate(Batch) noexcept override;
+
+private:
+    static constexpr std::size_t batch_size_ {tetromino::type_count};
+
+    bool InHistory(tetromino::Type) const noexcept;
+
+    Xoshiro256 eng_;
+
+    std::size_t rerolls_;
+
+    std::array<tetromino::Type, history_size> history_;
+
+    std::size_t history_pos_ {0};
+};
+
+/**
+ * @brief A fixed-capacity ring buffer of upcoming tetrominoes.
+ *
+ * @details
+ * Each tetromino is stored twice, @p capacity slots apart,
+ * so any window of the queue is contiguous and can be viewed without copying.
+ */
+class PieceQueue {
+public:
+    static constexpr std::size_t capacity {64};
+
+    static_assert(capacity > PieceGenerator::max_batch_size);
+
+    std::size_t GetSize() const noexcept {
+        return size_;
+    }
+
+    //! View the first tetrominoes from the front.
+    std::span<const Piece> Peek(const std::size_t count) const noexcept {
+        assert(count <= size_);
+        return {pieces_.data() + head_, count};
+    }
+
+    //! Remove the front tetromino.
+    Piece Pop() noexcept {
+        assert(size_ > 0);
+        const auto piece {pieces_[head_]};
+        head_ = (head_ + 1) % capacity;
+        --size_;
+        return piece;
+    }
+
+    /**
+     * @brief Generate batches until the queue holds at least a number of tetrominoes.
+     *
+     * @param generator A generator.
+     * @param count The minimum size, not greater than <tt>capacity - PieceGenerator::max_batch_size</tt>.
+     */
+    void Fill(PieceGenerator& generator, std::size_t count) noexcept;
+
+    void Clear() noexcept {
+        head_ = 0;
+        size_ = 0;
+    }
+
+private:
+    std::array<Piece, capacity * 2> pieces_;
+
+    std::size_t head_ {0};
+
+    std::size_t size_ {0};
+};
\ No newline at end of file
@@ -13,38 +13,60 @@
 #pragma once
 
 #include "location.h"
+#include "piece.h"
 #include "tetromino.h"
 
+#include <cstdint>
 #include <iostream>
+#include <limits>
 #include <memory>
 #include <optional>
+#include <span>
 #include <vector>
 
 
-//! The cell used for building a playing field.
-class Cell : public Colored {
-public:
-    bool Filled() const noexcept;
-
-    void Clear() noexcept;
-
-    Color GetColor() const noexcept override;
-
-    void SetColor(Color) noexcept override;
+//! A final placement of a tetromino.
+struct Placement {
+    Angle angle;
 
-    operator bool() const noexcept {
-        return Filled();
-    }
+    //! The position where the tetromino lands.
+    Point pos;
 
-private:
-    Color color_ {Color::Non};
+    constexpr bool operator==(const Placement&) const noexcept = default;
 };
 
-//! A playing field.
+class GridSnapshot;
+
+/**
+ * @brief A playing field.
+ *
+ * @details
+ * Forks and snapshots of a grid share the fixed tetrominoes until one of them changes them,
+ * so a search can fork a grid for each node cheaply. Plain copies are deep.
+ */
 class Grid : public Shape {
 public:
+    /**
+     * @brief A word of the occupancy bitboard.
+     *
+     * @details
+     * The bit @p i of a word represents the column @p i relative to the first column the word covers.
+     */
+    using RowMask = std::uint64_t;
+
+    static constexpr std::size_t row_mask_bits {
+        std::numeric_limits<RowMask>::digits};
+
     Grid(std::size_t width, std::size_t height) noexcept;
 
+    Grid(const Grid&) noexcept;
+
+    Grid(Grid&&) noexcept = default;
+
+    Grid& operator=(const Grid&) noexcept;
+
+    Grid& operator=(Grid&&) noexcept = default;
+
     std::size_t GetHeight() const noexcept override;
 
     std::size_t GetWidth() const noexcept override;
@@ -54,14 +76,106 @@ public:
 
     Color GetColor(const Point&) const noexcept;
 
+    /**
+     * @brief Get the occupancy bitboard of a row.
+     *
+     * @details
+     * It contains the fixed tetrominoes only. Bits beyond the width are clear.
+     *
+     * @param y A row.
+     * @return @p GetRowWordCount words covering the columns from left to right.
+     */
+    std::span<const RowMask> GetRowMask(std::size_t y) const noexcept;
+
+    //! Get the number of words per row in the occupancy bitboard.
+    std::size_t GetRowWordCount() const noexcept;
+
+    /**
+     * @brief Get the Zobrist hash of the fixed tetrominoes.
+     *
+     * @details
+     * It is the XOR of the keys of filled cells, ignoring colors and the current tetromino.
+     * It is updated incrementally when tetrominoes are fixed and lines are cleared.
+     * An empty grid has the hash @p 0.
+     */
+    std::uint64_t GetHash() const noexcept;
+
+    /**
+     * @brief Get the Zobrist key of a cell.
+     *
+     * @details
+     * Keys are derived from positions by a mixing function, so grids of any size need no key table.
+     */
+    static std::uint64_t GetCellKey(const Point&) noexcept;
+
+    /**
+     * @brief Whether a tetromino can be placed in a position without collisions.
+     *
+     * @details
+     * It ignores the current tetromino and does not allocate any memory.
+     */
+    bool CanPlace(tetromino::Type, Angle, const Point&) const noexcept;
+
+    /**
+     * @brief Get the position where a tetromino dropped straight down from a position lands.
+     *
+     * @details
+     * If the tetromino is above the top of each column it covers,
+     * the landing row is computed from column heights without testing collisions row by row.
+     *
+     * @param type A tetromino type.
+     * @param angle An angle.
+     * @param pos A position where the tetromino can be placed.
+     */
+    Point GetDropPosition(tetromino::Type type, Angle angle,
+                          const Point& pos) const noexcept;
+
+    //! Get the position where the current tetromino lands if it is dropped straight down.
+    Point GetDropPosition() const noexcept;
+
+    /**
+     * @brief Get all final placements a tetromino can reach from a position.
+     *
+     * @details
+     * A breadth-first search moves the tetromino left, right and down, and rotates it in place,
+     * as @p MoveTetrominoToLeft, @p MoveTetrominoToRight, @p TetrominoDescend and @p Rotate* do.
+     * A placement is final if the tetromino cannot descend any more.
+     * Symmetric rotations are reported once, with the smallest angle of the same layout.
+     * The current tetromino is ignored and the grid is not changed.
+     *
+     * @param type A tetromino type.
+     * @param angle The angle where the search starts.
+     * @param pos The position where the search starts.
+     * @return The placements in the order they are found, or nothing if the start has a collision.
+     */
+    std::vector<Placement> GetPlacements(tetromino::Type type, Angle angle,
+                                         const Point& pos) const noexcept;
+
+    //! Get all final placements the current tetromino can reach.
+    std::vector<Placement> GetPlacements() const noexcept;
+
     /**
      * @brief Push a tetromino into the grid.
      *
+     * @param piece A piece. Its own position is ignored.
+     * @param pos A position. The default is the entrance of the grid.
      * @return Whether the push succeeded. If it failed, the game should be over.
      */
+    bool PushTetromino(Piece piece,
+                       std::optional<Point> pos = std::nullopt) noexcept;
+
+    /**
+     * @brief Push a polymorphic tetromino into the grid.
+     *
+     * @details
+     * It is kept for compatibility and converts the tetromino to a @p Piece.
+     */
     bool PushTetromino(std::unique_ptr<Tetromino>,
                        std::optional<Point> pos = std::nullopt) noexcept;
 
+    //! Get the current tetromino.
+    const std::optional<Piece>& GetTetromino() const noexcept;
+
     /**
      * @brief Try to move the current tetromino 1 cell to the left.
      *
@@ -102,52 +216,76 @@ public:
      */
     bool TetrominoDescend(std::size_t& cleared_line_count) noexcept;
 
-    void Reset() noexcept;
-
-private:
-    class MovableTetromino :
-        public Shape,
-        public Rotatable,
-        public Colored,
-        public Movable {
-    public:
-        MovableTetromino(std::unique_ptr<Tetromino> tetromino,
-                         Point pos = {0, 0}) noexcept;
-
-        Angle GetAngle() const noexcept override;
-
-        void RotateLeft() noexcept override;
-
-        void RotateRight() noexcept override;
-
-        void RotateTo(Angle) noexcept override;
+    /**
+     * @brief Drop the current tetromino straight down and fix it.
+     *
+     * @details
+     * Full lines will be cleared and a new tetromino should be pushed by calling @p PushTetromino.
+     *
+     * @param[out] cleared_line_count The number of cleared lines.
+     */
+    void TetrominoHardDrop(std::size_t& cleared_line_count) noexcept;
 
-        void SetPosition(Point) noexcept override;
+    void Reset() noexcept;
 
-        Point GetPosition() const noexcept override;
+    /**
+     * @brief Take a snapshot of the fixed tetrominoes and the current tetromino.
+     *
+     * @details
+     * Nothing is copied until the grid is changed.
+     */
+    GridSnapshot Snapshot() const noexcept;
 
-        std::size_t GetHeight() const noexcept override;
+    //! Restore a snapshot taken from a grid of the same size.
+    void Restore(const GridSnapshot&) noexcept;
 
-        std::size_t GetWidth() const noexcept override;
+    /**
+     * @brief Create a copy-on-write copy of the grid.
+     *
+     * @details
+     * The copy shares the fixed tetrominoes with the grid.
+     * Whichever changes them first clones them, so a fork costs only a reference until then.
+     */
+    Grid Fork() const noexcept;
 
-        bool Filled(const Point&) const noexcept override;
+    /**
+     * @brief Get the rows that differ from an earlier state of the grid, e.g. the last drawn frame.
+     *
+     * @details
+     * A row is dirty if its fixed cells have changed, e.g. by fixing or clearing lines,
+     * or the current tetromino has entered or left it by moving, rotating or being pushed.
+     * Fixed cells are only compared when the two grids do not share them,
+     * so comparing with a fork of the last frame costs nothing until the grid is changed.
+     *
+     * @param since A grid of the same size.
+     * @return Whether each row is dirty.
+     */
+    std::vector<bool> GetDirtyRows(const Grid& since) const noexcept;
 
-        Color GetColor() const noexcept override;
+private:
+    static constexpr std::size_t min_width_ {4};
 
-        void SetColor(Color) noexcept override;
+    static constexpr std::size_t min_height_ {4};
 
-        std::unique_ptr<MovableTetromino> GetTetrominoByAngle(
-            Angle) const noexcept;
+    //! Whether a position is filled in the occupancy bitboard. The position must be inside the grid.
+    bool TestCell(const Point&) const noexcept;
 
-    private:
-        Point pos_;
+    //! Mark a position as filled in the occupancy bitboard.
+    void SetCell(const Point&) noexcept;
 
-        std::unique_ptr<Tetromino> tetromino_;
-    };
+    //! Get the first word of a row in the occupancy bitboard.
+    RowMask* GetRow(std::size_t y) noexcept;
 
-    static constexpr std::size_t min_width_ {4};
+    const RowMask* GetRow(std::size_t y) const noexcept;
 
-    static constexpr std::size_t min_height_ {4};
+    /**
+     * @brief Whether a row mask overlaps a row of the grid.
+     *
+     * @param y A row.
+     * @param x The column where the bit 0 of the mask is placed.
+     * @param mask A row mask whose bits exceeding the grid border are treated as collisions.
+     */
+    bool RowOverlaps(std::size_t y, std::size_t x, RowMask mask) const noexcept;
 
     /**
      * @brief
@@ -159,8 +297,8 @@ private:
     //! Whether a position is filled by the current tetromino.
     bool FilledByTetromino(const Point&) const noexcept;
 
-    //! Whether a shape has a collision in a position.
-    bool HasCollision(const Shape&, const Point&) const noexcept;
+    //! Whether a precomputed tetromino layout has a collision in a position.
+    bool HasCollision(const tetromino::ShapeMask&, const Point&) const noexcept;
 
     //! Whether the current tetromino can be moved to a position.
     bool CanMoveTetrominoTo(const Point&) const noexcept;
@@ -168,21 +306,53 @@ private:
     //! Try to move the current tetromino to a position.
     bool MoveTetrominoTo(const Point&) noexcept;
 
-    void ClearCells(const Point& pos, const std::size_t x_len,
-                    const std::size_t y_len) noexcept;
+    //! Try to rotate the current tetromino to an angle in its current position.
+    bool RotateTetrominoTo(Angle) noexcept;
+
+    //! Get the first color of a row in the color plane.
+    Color* GetColorRow(std::size_t y) noexcept;
+
+    const Color* GetColorRow(std::size_t y) const noexcept;
+
+    /**
+     * @brief Move consecutive rows to another position.
+     *
+     * @details
+     * The occupancy bitboard, the color plane and the row counters are each moved by a single @p memmove.
+     *
+     * @param src The first source row.
+     * @param row_count The number of rows.
+     * @param dst The first destination row. The ranges can overlap.
+     */
+    void MoveRows(std::size_t src, std::size_t row_count,
+                  std::size_t dst) noexcept;
+
+    //! Clear consecutive rows.
+    void ClearRows(std::size_t y, std::size_t row_count) noexcept;
 
     //! Fix the current tetromino to the grid.
     void FixTetromino() noexcept;
 
     /**
-     * @brief Clear all full lines.
+     * @brief Fix the current tetromino and clear the lines it completes.
      *
      * @return The number of cleared lines.
      */
-    std::size_t ClearLines() noexcept;
+    std::size_t LockTetromino() noexcept;
 
-    //! Clear a full line.
-    void ClearLine(std::size_t y) noexcept;
+    /**
+     * @brief Clear the full lines in a range of rows.
+     *
+     * @details
+     * Only the rows touched by the last fixed tetromino can be full.
+     * Rows above the full lines are compacted downward, stopping at the first empty row.
+     * Each block of rows between two full lines is moved at once.
+     *
+     * @param y The first row.
+     * @param row_count The number of rows.
+     * @return The number of cleared lines.
+     */
+    std::size_t ClearLines(std::size_t y, std::size_t row_count) noexcept;
 
     //! Whether a line is full.
     bool IsLineFull(std::size_t y) const noexcept;
@@ -190,6 +360,56 @@ private:
     //! Whether a line is empty.
     bool IsLineEmpty(std::size_t y) const noexcept;
 
+    //! Get the highest filled row of a column below a row, or the height if there is none.
+    std::size_t FindColumnTop(std::size_t x, std::size_t y) const noexcept;
+
+    //! Get the XOR of the keys of filled cells in consecutive rows.
+    std::uint64_t HashRows(std::size_t y, std::size_t row_count) const noexcept;
+
+    //! The fixed tetrominoes.
+    struct Board {
+        Board(std::size_t width, std::size_t height,
+              std::size_t row_words) noexcept;
+
+        /**
+         * @brief The occupancy bitboard in row-major order.
+         *
+         * @details
+         * Each row takes @p row_words_ words. A bit is set if the cell is filled by fixed tetrominoes.
+         */
+        std::vector<RowMask> rows;
+
+        //! The number of filled cells in each row.
+        std::vector<std::size_t> row_counts;
+
+        /**
+         * @brief The highest filled row of each column, or the height if a column is empty.
+         *
+         * @details
+         * It is updated when tetrominoes are fixed and lines are cleared.
+         */
+        std::vector<std::size_t> column_tops;
+
+        /**
+         * @brief The color plane in row-major order.
+         *
+         * @details
+         * Each row takes @p width_ bytes. An empty cell is @p Color::Non.
+         */
+        std::vector<Color> colors;
+
+        //! The Zobrist hash of the filled cells.
+        std::uint64_t hash {0};
+    };
+
+    //! Create a grid with the same state as another one but a different board.
+    Grid(const Grid& other, std::shared_ptr<Board> board) noexcept;
+
+    //! Get the board for changing, cloning it first if it is shared.
+    Board& GetMutableBoard() noexcept;
+
+    friend class GridSnapshot;
+
     std::size_t width_;
 
     std::size_t height_;
@@ -197,9 +417,35 @@ private:
     //! The push entrance of tetrominoes.
     Point entrance_;
 
-    std::vector<std::vector<Cell>> cells_;
+    //! The number of words per row in the occupancy bitboard.
+    std::size_t row_words_;
+
+    //! The mask of valid bits in the last word of a row.
+    RowMask last_word_mask_;
+
+    //! The board shared by copies and snapshots until one of them changes it.
+    std::shared_ptr<Board> board_;
+
+    std::optional<Piece> tetromino_;
+};
+
+/**
+ * @brief A snapshot of a grid.
+ *
+ * @details
+ * It shares the fixed tetrominoes with the grid, so taking and restoring one copies nothing.
+ */
+class GridSnapshot {
+private:
+    friend class Grid;
+
+    GridSnapshot(std::shared_ptr<const Grid::Board> board,
+                 std::optional<Piece> tetromino) noexcept :
+        board_ {std::move(board)}, tetromino_ {tetromino} {}
+
+    std::shared_ptr<const Grid::Board> board_;
 
-    std::unique_ptr<MovableTetromino> tetromino_;
+    std::optional<Piece> tetromino_;
 };
 
 //! Print a grid, usually only for debugging.
@@ -0,0 +1,81 @@
+/**
+ * @file latency.h
+ * @brief The latency histogram.
+ *
+ * @author Chen Zhenshuo (chenzs108@outlook.com)
+ * @par GitHub
+ * https://github.com/Zhuagenborn
+ * @version 1.0
+ * @date 2023-05-10
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+/**
+ * @brief A histogram of durations with a bounded relative error, in the style of @em HdrHistogram.
+ *
+ * @details
+ * Durations are counted in nanoseconds.
+ * Values below @p 2^sub_bucket_bits are counted exactly.
+ * Larger values are split into power-of-2 ranges of @p 2^(sub_bucket_bits-1) equal buckets each,
+ * so the error of a percentile is less than 1 / @p 2^(sub_bucket_bits-1) of its value.
+ * Recording takes constant time and never allocates.
+ *
+ * @warning
+ * It is not thread-safe.
+ */
+class LatencyHistogram {
+public:
+    using Duration = std::chrono::nanoseconds;
+
+    static constexpr std::size_t sub_bucket_bits {7};
+
+    LatencyHistogram() noexcept;
+
+    //! Record a duration. Negative durations are recorded as @p 0.
+    void Record(Duration) noexcept;
+
+    std::size_t GetCount() const noexcept;
+
+    Duration GetMin() const noexcept;
+
+    Duration GetMax() const noexcept;
+
+    /**
+     * @brief Get the duration that a percentage of records do not exceed.
+     *
+     * @param percentile A percentage between @p 0 and @p 100.
+     * @return The highest duration of the bucket containing the percentile, or @p 0 if there are no records.
+     */
+    Duration GetPercentile(double percentile) const noexcept;
+
+    //! Add the records of another histogram.
+    void Merge(const LatencyHistogram&) noexcept;
+
+    void Clear() noexcept;
+
+private:
+    static constexpr std::size_t sub_bucket_count {std::size_t {1}
+                                                   << sub_bucket_bits};
+
+    static constexpr std::size_t half_sub_bucket_count {sub_bucket_count / 2};
+
+    static std::size_t GetBucket(std::uint64_t value) noexcept;
+
+    //! Get the highest value of a bucket.
+    static std::uint64_t GetHighestValue(std::size_t bucket) noexcept;
+
+    std::vector<std::size_t> counts_;
+
+    std::size_t count_ {0};
+
+    std::uint64_t min_ {UINT64_MAX};
+
+    std::uint64_t max_ {0};
+};
\ No newline at end of file
@@ -18,6 +18,8 @@ struct Point {
     constexpr Point(const std::size_t x = 0, const std::size_t y = 0) noexcept :
         x {x}, y {y} {}
 
+    constexpr bool operator==(const Point&) const noexcept = default;
+
     std::size_t x;
     std::size_t y;
 };
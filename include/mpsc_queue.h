@@ -0,0 +1,117 @@
+/**
+ * @file mpsc_queue.h
+ * @brief The lock-free multi-producer single-consumer queue.
+ *
+ * @author Chen Zhenshuo (chenzs108@outlook.com)
+ * @par GitHub
+ * https://github.com/Zhuagenborn
+ * @version 1.0
+ * @date 2023-05-10
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <optional>
+#include <type_traits>
+
+
+/**
+ * @brief A bounded queue that any number of threads push into and one thread pops from.
+ *
+ * @details
+ * Each cell has a sequence number telling whether it is free for the push of a round or holds its value.
+ * Producers claim cells by advancing the tail with a compare-and-swap and never wait for each other.
+ * A push fails instead of blocking when the queue is full.
+ *
+ * @tparam T A value type.
+ * @tparam capacity The number of cells. It must be a power of 2.
+ */
+template <typename T, std::size_t capacity>
+    requires std::is_nothrow_copy_assignable_v<T>
+             && std::is_nothrow_default_constructible_v<T>
+             && (std::has_single_bit(capacity))
+class MpscQueue {
+public:
+    MpscQueue() noexcept {
+        for (std::size_t i {0}; i < capacity; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    /**
+     * @brief Push a value. It can be called from any thread.
+     *
+     * @return Whether the value has been pushed. It fails if the queue is full.
+     */
+    bool TryPush(const T& value) noexcept {
+        auto pos {tail_.load(std::memory_order_relaxed)};
+        while (true) {
+            auto& cell {cells_[pos & mask]};
+            const auto seq {cell.sequence.load(std::memory_order_acquire)};
+            if (seq == pos) {
+                if (tail_.compare_exchange_weak(pos, pos + 1,
+                                                std::memory_order_relaxed)) {
+                    cell.value = value;
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (seq < pos) {
+                // The cell still holds the value of the previous round.
+                return false;
+            } else {
+                // Another producer has claimed the cell.
+                pos = tail_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief Pop the oldest value.
+     *
+     * @warning
+     * It must only be called from the consumer thread.
+     */
+    std::optional<T> TryPop() noexcept {
+        auto& cell {cells_[head_ & mask]};
+        if (cell.sequence.load(std::memory_order_acquire) != head_ + 1) {
+            return std::nullopt;
+        }
+
+        const T value {cell.value};
+        cell.sequence.store(head_ + capacity, std::memory_order_release);
+        ++head_;
+        return value;
+    }
+
+private:
+    static constexpr std::size_t mask {capacity - 1};
+
+    /**
+     * @brief The alignment keeping producers and the consumer on different cache lines.
+     *
+     * @note
+     * @p std::hardware_destructive_interference_size is not used since it may differ between compilation units including this header.
+     */
+    static constexpr std::size_t cache_line_size {64};
+
+    struct Cell {
+        std::atomic<std::size_t> sequence;
+        T value {};
+    };
+
+    std::array<Cell, capacity> cells_;
+
+    //! The position of the next push, shared by producers.
+    alignas(cache_line_size) std::atomic<std::size_t> tail_ {0};
+
+    //! The position of the next pop, owned by the consumer.
+    alignas(cache_line_size) std::size_t head_ {0};
+};
\ No newline at end of file
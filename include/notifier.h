@@ -0,0 +1,84 @@
+/**
+ * @file notifier.h
+ * @brief The wake-up notifier of a waiting thread.
+ *
+ * @author Chen Zhenshuo (chenzs108@outlook.com)
+ * @par GitHub
+ * https://github.com/Zhuagenborn
+ * @version 1.0
+ * @date 2023-05-10
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <stop_token>
+
+
+/**
+ * @brief A flag waking up a thread waiting for it, a deadline or a stop request.
+ *
+ * @details
+ * Notifications before a wait are not lost, and several ones are merged into one.
+ * Notifying only sets an atomic flag while the thread is awake.
+ * The lock is only taken to wake up the thread when it is waiting, and never while the thread works.
+ *
+ * @note
+ * @p std::counting_semaphore is not used since the timed wait of some standard libraries
+ * polls with a backoff, which delays waking up by milliseconds.
+ */
+class Notifier {
+public:
+    //! Wake up the waiting thread. It can be called from any thread.
+    void Notify() noexcept {
+        // Both the flags are sequentially consistent,
+        // so either the waiting thread sees the notification or this thread sees it waiting.
+        notified_.store(true);
+        if (waiting_.load()) {
+            // The waiting thread holds the lock until it is blocked, so the notification cannot be missed.
+            {
+                const std::lock_guard lock {mtx_};
+            }
+
+            cv_.notify_one();
+        }
+    }
+
+    /**
+     * @brief Wait until notified, a deadline is reached or a stop is requested.
+     *
+     * @param deadline A deadline, or @p time_point::max() to wait without one.
+     * @return Whether it has been notified. The notification is consumed.
+     */
+    bool WaitUntil(const std::chrono::steady_clock::time_point deadline,
+                   const std::stop_token token) noexcept {
+        if (notified_.exchange(false)) {
+            return true;
+        }
+
+        std::unique_lock lock {mtx_};
+        waiting_.store(true);
+        cv_.wait_until(lock, token, deadline,
+                       [this]() { return notified_.load(); });
+        waiting_.store(false);
+        return notified_.exchange(false);
+    }
+
+    //! Discard a notification that has not been waited for.
+    void Reset() noexcept {
+        notified_.store(false);
+    }
+
+private:
+    std::mutex mtx_;
+
+    std::condition_variable_any cv_;
+
+    std::atomic_bool notified_ {false};
+
+    //! Whether the thread is waiting or about to wait.
+    std::atomic_bool waiting_ {false};
+};
\ No newline at end of file
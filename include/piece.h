@@ -0,0 +1,135 @@
+/**
+ * @file piece.h
+ * @brief The lightweight tetromino value.
+ *
+ * @author Chen Zhenshuo (chenzs108@outlook.com)
+ * @par GitHub
+ * https://github.com/Zhuagenborn
+ * @version 1.0
+ * @date 2023-05-02
+ */
+
+#pragma once
+
+#include "color.h"
+#include "location.h"
+#include "rotation.h"
+#include "tetromino.h"
+
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <type_traits>
+
+
+/**
+ * @brief A tetromino with a position.
+ *
+ * @details
+ * Unlike @p Tetromino, it is a trivially copyable value of a few bytes,
+ * so spawning, previewing and cloning a piece never allocates memory.
+ * Its layout comes from the precomputed shape masks.
+ */
+class Piece {
+public:
+    constexpr Piece(const tetromino::Type type = tetromino::Type::I,
+                    const Angle angle = Angle::Degree0,
+                    const Color color = Color::Non,
+                    const Point& pos = {0, 0}) noexcept :
+        type_ {type}, angle_ {angle}, color_ {color} {
+        SetPosition(pos);
+    }
+
+    /**
+     * @brief Create a piece at the origin.
+     *
+     * @param color A color. If it is empty or @p Color::Non, a random color will be used.
+     */
+    static Piece Create(tetromino::Type type, Angle angle = Angle::Degree0,
+                        std::optional<Color> color = std::nullopt) noexcept;
+
+    //! Convert a polymorphic tetromino to a piece at the origin.
+    static Piece From(const Tetromino&) noexcept;
+
+    //! Convert the piece to a polymorphic tetromino.
+    std::unique_ptr<Tetromino> ToTetromino() const noexcept;
+
+    constexpr tetromino::Type GetType() const noexcept {
+        return type_;
+    }
+
+    constexpr Angle GetAngle() const noexcept {
+        return angle_;
+    }
+
+    constexpr void RotateLeft() noexcept {
+        angle_ = RotateAngleLeft(angle_);
+    }
+
+    constexpr void RotateRight() noexcept {
+        angle_ = RotateAngleRight(angle_);
+    }
+
+    constexpr void RotateTo(const Angle angle) noexcept {
+        angle_ = angle;
+    }
+
+    constexpr Color GetColor() const noexcept {
+        return color_;
+    }
+
+    constexpr void SetColor(const Color color) noexcept {
+        color_ = color;
+    }
+
+    constexpr Point GetPosition() const noexcept {
+        return {x_, y_};
+    }
+
+    constexpr void SetPosition(const Point& pos) noexcept {
+        assert(pos.x <= std::numeric_limits<Coordinate>::max()
+               && pos.y <= std::numeric_limits<Coordinate>::max());
+        x_ = static_cast<Coordinate>(pos.x);
+        y_ = static_cast<Coordinate>(pos.y);
+    }
+
+    //! Get the precomputed layout of the current angle.
+    const tetromino::ShapeMask& GetShapeMask() const noexcept {
+        return tetromino::GetShapeMask(type_, angle_);
+    }
+
+    std::size_t GetHeight() const noexcept {
+        return GetShapeMask().height;
+    }
+
+    std::size_t GetWidth() const noexcept {
+        return GetShapeMask().width;
+    }
+
+    //! Whether a position relative to the top-left corner of the piece is filled.
+    bool Filled(const Point& pos) const noexcept {
+        return GetShapeMask().Filled(pos);
+    }
+
+    constexpr bool operator==(const Piece&) const noexcept = default;
+
+private:
+    using Coordinate = std::uint16_t;
+
+    tetromino::Type type_;
+
+    Angle angle_;
+
+    Color color_;
+
+    Coordinate x_ {0};
+
+    Coordinate y_ {0};
+};
+
+static_assert(std::is_trivially_copyable_v<Piece>);
+
+std::ostream& operator<<(std::ostream&, const Piece&) noexcept;
\ No newline at end of file
@@ -0,0 +1,236 @@
+/**
+ * @file policy.h
+ * @brief Players of headless games.
+ *
+ * @author Chen Zhenshuo (chenzs108@outlook.com)
+ * @par GitHub
+ * https://github.com/Zhuagenborn
+ * @version 1.0
+ * @date 2023-05-04
+ */
+
+#pragma once
+
+#include "feature.h"
+#include "game.h"
+#include "pool.h"
+#include "transposition.h"
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <random>
+#include <span>
+#include <vector>
+
+
+//! A player choosing actions for a headless game.
+class Policy {
+public:
+    /**
+     * @brief Choose the next action.
+     *
+     * @return An action. @p Action::Non means waiting for the next gravity tick.
+     */
+    virtual Action Decide(const Game&) noexcept = 0;
+
+    virtual ~Policy() noexcept = default;
+};
+
+//! Create a policy for a game with a seed.
+using PolicyFactory =
+    std::function<std::unique_ptr<Policy>(std::uint64_t seed)>;
+
+//! A policy choosing movements, rotations and descents uniformly at random.
+class RandomPolicy : public Policy {
+public:
+    explicit RandomPolicy(std::uint64_t seed) noexcept;
+
+    Action Decide(const Game&) noexcept override;
+
+private:
+    std::mt19937_64 eng_;
+};
+
+/**
+ * @brief A policy planning where to place each tetromino and executing the placement.
+ *
+ * @details
+ * A placement is planned once when a tetromino is pushed,
+ * and executed by rotations, movements and a hard drop.
+ */
+class PlacementPolicy : public Policy {
+public:
+    Action Decide(const Game&) noexcept final;
+
+protected:
+    /**
+     * @brief Choose where to place the current tetromino of a grid.
+     *
+     * @param grid A grid with a current tetromino.
+     * @param next The next tetrominoes.
+     * @return
+     * A placement reachable by rotating in place, moving horizontally and then dropping straight down,
+     * or nothing to drop the tetromino where it is.
+     */
+    virtual std::optional<Placement> Plan(
+        const Grid& grid, std::span<const Piece> next) noexcept = 0;
+
+private:
+    //! The number of pushed tetrominoes when the target was planned.
+    std::size_t planned_piece_count_ {0};
+
+    std::optional<Placement> target_;
+};
+
+/**
+ * @brief A policy placing each tetromino where a weighted sum of board features is the highest.
+ *
+ * @details
+ * Each reachable placement of the current tetromino is scored with the best placement of the first next tetromino.
+ */
+class HeuristicPolicy : public PlacementPolicy {
+public:
+    explicit HeuristicPolicy(FeatureWeights weights = {}) noexcept;
+
+protected:
+    std::optional<Placement> Plan(const Grid&,
+                                  std::span<const Piece> next) noexcept override;
+
+private:
+    /**
+     * @brief Score the best reachable placement of a tetromino.
+     *
+     * @param grid A grid whose current tetromino is the one to place.
+     * @param cleared_line_count The number of lines cleared before the placement.
+     * @return The score, or nothing if the tetromino has no placement.
+     */
+    std::optional<double> EvaluateBest(
+        const Grid& grid, std::size_t cleared_line_count) noexcept;
+
+    FeatureWeights weights_;
+
+    FeatureExtractor extractor_;
+};
+
+//! The statistics of searches.
+struct SearchStats {
+    //! Get the number of evaluated nodes per second.
+    double GetNodesPerSecond() const noexcept;
+
+    std::size_t search_count {0};
+
+    //! The number of evaluated nodes.
+    std::size_t node_count {0};
+
+    //! The number of nodes whose evaluations were found in the transposition table.
+    std::size_t cache_hit_count {0};
+
+    //! The number of searches stopped by the deadline.
+    std::size_t timeout_count {0};
+
+    std::chrono::steady_clock::duration elapsed {0};
+};
+
+/**
+ * @brief A policy searching placements over the next tetrominoes with a beam search.
+ *
+ * @details
+ * The nodes of a depth are the grids after placing the current tetromino and the first few next tetrominoes.
+ * Each depth expands every reachable placement of its tetromino from the nodes kept by the previous depth,
+ * scores the children by board features and keeps the best ones.
+ * Children reaching the same board are kept once, and board evaluations are cached in a transposition table.
+ * The current tetromino is placed as the first placement of the best node of the deepest finished depth.
+ * Nodes of a depth are expanded in parallel and the result does not depend on the number of threads.
+ */
+class BeamSearchPolicy : public PlacementPolicy {
+public:
+    /**
+     * @param pool
+     * A thread pool expanding nodes in parallel, or @p nullptr to expand them in the calling thread.
+     * It must not be used by anything else while the policy is deciding.
+     * @param weights Weights of board features.
+     */
+    explicit BeamSearchPolicy(std::shared_ptr<WorkStealingPool> pool = nullptr,
+                              FeatureWeights weights = {}) noexcept;
+
+    //! Set the number of nodes kept at each depth. The minimum is 1.
+    BeamSearchPolicy& SetBeamWidth(std::size_t) noexcept;
+
+    //! Set the maximum number of next tetrominoes to look ahead. The default is all of them.
+    BeamSearchPolicy& SetMaxDepth(std::size_t) noexcept;
+
+    /**
+     * @brief Set a time budget for planning each tetromino.
+     *
+     * @details
+     * When the budget runs out, the search stops and uses the deepest finished depth.
+     * The placements of the current tetromino are always searched.
+     */
+    BeamSearchPolicy& SetDeadline(
+        std::optional<std::chrono::steady_clock::duration>) noexcept;
+
+    /**
+     * @brief Set the transposition table caching board evaluations, or @p nullptr to disable caching.
+     *
+     * @details
+     * By default, each policy owns a table.
+     * A table can be shared by policies with the same weights.
+     */
+    BeamSearchPolicy& SetTranspositionTable(
+        std::shared_ptr<TranspositionTable>) noexcept;
+
+    const SearchStats& GetStats() const noexcept;
+
+protected:
+    std::optional<Placement> Plan(const Grid&,
+                                  std::span<const Piece> next) noexcept override;
+
+private:
+    struct Node {
+        //! The grid after placing the tetrominoes.
+        Grid grid;
+
+        //! The placement of the current tetromino leading to the node.
+        Placement first;
+
+        double score;
+
+        //! The number of lines cleared since the root.
+        std::size_t line_count;
+    };
+
+    static constexpr std::size_t default_table_capacity {1 << 16};
+
+    /**
+     * @brief Add a child for each reachable placement of the current tetromino of a node.
+     *
+     * @return The number of children whose evaluations were found in the transposition table.
+     */
+    std::size_t Expand(const Node&, bool root, std::vector<Node>& children,
+                       FeatureExtractor&) noexcept;
+
+    std::shared_ptr<WorkStealingPool> pool_;
+
+    std::shared_ptr<TranspositionTable> table_ {
+        std::make_shared<TranspositionTable>(default_table_capacity)};
+
+    FeatureWeights weights_;
+
+    std::size_t beam_width_ {32};
+
+    std::size_t max_depth_ {std::numeric_limits<std::size_t>::max()};
+
+    std::optional<std::chrono::steady_clock::duration> deadline_;
+
+    //! An extractor for each worker.
+    std::vector<FeatureExtractor> extractors_;
+
+    //! The children of each node, reused between depths.
+    std::vector<std::vector<Node>> children_;
+
+    SearchStats stats_;
+};
\ No newline at end of file
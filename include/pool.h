@@ -0,0 +1,56 @@
+/**
+ * @file pool.h
+ * @brief The work-stealing thread pool.
+ *
+ * @author Chen Zhenshuo (chenzs108@outlook.com)
+ * @par GitHub
+ * https://github.com/Zhuagenborn
+ * @version 1.0
+ * @date 2023-05-04
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+
+/**
+ * @brief A thread pool running indexed tasks with work stealing.
+ *
+ * @details
+ * Each worker owns a contiguous range of task indices and takes tasks from its front.
+ * An idle worker steals the back half of another worker's range.
+ * Ranges are packed into atomic words, so neither taking nor stealing locks.
+ * The calling thread works as the first worker.
+ */
+class WorkStealingPool {
+public:
+    /**
+     * @brief A task.
+     *
+     * @param index The task index.
+     * @param worker The index of the worker running the task, less than @p GetThreadCount.
+     */
+    using Task = std::function<void(std::size_t index, std::size_t worker)>;
+
+    //! Create a pool. The default number of threads is the number of hardware threads.
+    explicit WorkStealingPool(std::size_t thread_count = 0) noexcept;
+
+    std::size_t GetThreadCount() const noexcept;
+
+    /**
+     * @brief Run a task for each index in <tt>[0, count)</tt> and wait for all of them.
+     *
+     * @warning It must not be called concurrently or from inside a task.
+     */
+    void ParallelFor(std::size_t count, const Task& task) noexcept;
+
+    ~WorkStealingPool() noexcept;
+
+private:
+    class Impl;
+
+    std::unique_ptr<Impl> impl_;
+};
\ No newline at end of file
@@ -0,0 +1,78 @@
+/**
+ * @file random.h
+ * @brief The fast pseudo-random number generator.
+ *
+ * @author Chen Zhenshuo (chenzs108@outlook.com)
+ * @par GitHub
+ * https://github.com/Zhuagenborn
+ * @version 1.0
+ * @date 2023-05-05
+ */
+
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <limits>
+
+
+/**
+ * @brief The @p xoshiro256** generator.
+ *
+ * @details
+ * It satisfies @p UniformRandomBitGenerator and keeps 32 bytes of state,
+ * so each game can own one cheaply. Its state is expanded from a 64-bit seed by @p splitmix64.
+ */
+class Xoshiro256 {
+public:
+    using result_type = std::uint64_t;
+
+    constexpr explicit Xoshiro256(std::uint64_t seed = 0) noexcept {
+        for (auto& s : state_) {
+            seed += 0x9E3779B97F4A7C15;
+            auto z {seed};
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EB;
+            s = z ^ (z >> 31);
+        }
+    }
+
+    static constexpr result_type min() noexcept {
+        return std::numeric_limits<result_type>::min();
+    }
+
+    static constexpr result_type max() noexcept {
+        return std::numeric_limits<result_type>::max();
+    }
+
+    constexpr result_type operator()() noexcept {
+        const auto result {std::rotl(state_[1] * 5, 7) * 9};
+        const auto t {state_[1] << 17};
+        state_[2] ^= state_[0];
+        state_[3] ^= state_[1];
+        state_[1] ^= state_[2];
+        state_[0] ^= state_[3];
+        state_[2] ^= t;
+        state_[3] = std::rotl(state_[3], 45);
+        return result;
+    }
+
+    //! Get an unbiased random integer in <tt>[0, bound)</tt> by Lemire's multiply-shift method.
+    constexpr std::uint64_t Below(const std::uint64_t bound) noexcept {
+        using Wide = unsigned __int128;
+        auto product {static_cast<Wide>((*this)()) * bound};
+        if (auto low {static_cast<std::uint64_t>(product)}; low < bound) {
+            const auto threshold {-bound % bound};
+            while (low < threshold) {
+                product = static_cast<Wide>((*this)()) * bound;
+                low = static_cast<std::uint64_t>(product);
+            }
+        }
+
+        return static_cast<std::uint64_t>(product >> 64);
+    }
+
+private:
+    std::array<std::uint64_t, 4> state_ {};
+};
\ No newline at end of file
@@ -0,0 +1,128 @@
+/**
+ * @file replay.h
+ * @brief The compact binary replay format.
+ *
+ * @author Chen Zhenshuo (chenzs108@outlook.com)
+ * @par GitHub
+ * https://github.com/Zhuagenborn
+ * @version 1.0
+ * @date 2023-05-06
+ */
+
+#pragma once
+
+#include "game.h"
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <optional>
+
+
+/**
+ * @brief The settings needed to reproduce a game.
+ *
+ * @details
+ * A replay starts with:
+ *
+ * ```
+ * "TTRP" <version: u8>
+ * <width> <height> <seed> <next count> <descend time in nanoseconds> <randomizer>
+ * ```
+ *
+ * All integers after the version are unsigned LEB128 varints.
+ */
+struct ReplayHeader {
+    std::size_t width {0};
+
+    std::size_t height {0};
+
+    std::uint64_t seed {0};
+
+    std::size_t next_count {1};
+
+    std::chrono::steady_clock::duration descend_time {};
+
+    Randomizer randomizer {Randomizer::Uniform};
+
+    //! Create the settings of a headless game.
+    GameSettings ToSettings() const noexcept;
+};
+
+/**
+ * @brief The final statistics of a recorded game, used to verify its replay.
+ *
+ * @details
+ * The header is followed by records of actions, each one varint of
+ * <tt>(tick - previous tick) << 3 | action</tt>.
+ * The action code @p 7 ends the records,
+ * and is followed by the score, the line count and the piece count.
+ */
+struct ReplayTrailer {
+    std::size_t tick_count {0};
+
+    std::size_t score {0};
+
+    std::size_t line_count {0};
+
+    std::size_t piece_count {0};
+
+    bool operator==(const ReplayTrailer&) const noexcept = default;
+};
+
+/**
+ * @brief A recorder streaming the actions of a game to a replay.
+ *
+ * @details
+ * Gravity is not recorded. It is reproduced by ticking the replayed game
+ * until the tick at which each action happened.
+ */
+class ReplayRecorder {
+public:
+    explicit ReplayRecorder(std::ostream&) noexcept;
+
+    /**
+     * @brief Write the header and start recording the actions of a started game.
+     *
+     * @warning The game must use a built-in randomizer and must outlive the recording.
+     */
+    void Attach(Game&) noexcept;
+
+    //! Stop recording and write the trailer.
+    void Finish() noexcept;
+
+    ~ReplayRecorder() noexcept;
+
+private:
+    void Record(std::size_t tick, Action) noexcept;
+
+    std::ostream& os_;
+
+    Game* game_ {nullptr};
+
+    std::size_t last_tick_ {0};
+};
+
+//! The result of playing a replay.
+struct ReplayResult {
+    //! The replayed headless game.
+    std::unique_ptr<Game> game;
+
+    ReplayHeader header;
+
+    //! The statistics recorded in the replay.
+    ReplayTrailer recorded;
+
+    //! Get the statistics of the replayed game.
+    ReplayTrailer GetReplayed() const noexcept;
+
+    //! Whether the replayed game ended with the recorded statistics.
+    bool Matched() const noexcept;
+};
+
+/**
+ * @brief Re-drive a headless game from a replay as fast as possible.
+ *
+ * @return The result, or @p std::nullopt if the replay is malformed.
+ */
+std::optional<ReplayResult> PlayReplay(std::istream&) noexcept;
\ No newline at end of file
@@ -12,12 +12,13 @@
 
 #pragma once
 
+#include <cstdint>
 #include <iostream>
 #include <string>
 #include <type_traits>
 
 
-enum class Angle { Degree0, Degree90, Degree180, Degree270 };
+enum class Angle : std::uint8_t { Degree0, Degree90, Degree180, Degree270 };
 
 inline constexpr std::size_t angle_count {4};
 
@@ -0,0 +1,70 @@
+/**
+ * @file row_scan.h
+ * @brief Vectorized scans of occupancy bitboard rows.
+ *
+ * @details
+ * Only wide rows benefit from AVX2. SSE2 is not provided, as it is slower than the word-by-word loop.
+ *
+ * @author Chen Zhenshuo (chenzs108@outlook.com)
+ * @par GitHub
+ * https://github.com/Zhuagenborn
+ * @version 1.0
+ * @date 2023-05-07
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <iostream>
+#include <span>
+#include <string>
+
+
+namespace row_scan {
+
+//! A word of a bitboard row. Each bit represents a cell.
+using Word = std::uint64_t;
+
+//! Implementations of row scans.
+enum class Kernel {
+    //! A word-by-word loop running on any CPU.
+    Portable,
+
+    //! 256 cells at a time with AVX2.
+    AVX2
+};
+
+std::string to_string(Kernel) noexcept;
+
+std::ostream& operator<<(std::ostream&, Kernel) noexcept;
+
+//! Whether the CPU supports a kernel.
+bool IsSupported(Kernel) noexcept;
+
+//! Get the fastest kernel supported by the CPU. It is detected once at runtime.
+Kernel GetBestKernel() noexcept;
+
+/**
+ * @brief Whether all cells of a row are filled.
+ *
+ * @param kernel A supported kernel.
+ * @param words The words of a row.
+ * @param last_mask The valid bits of the last word.
+ */
+bool AllSet(Kernel kernel, std::span<const Word> words, Word last_mask) noexcept;
+
+//! Whether all cells of a row are filled, using the best kernel.
+bool AllSet(std::span<const Word> words, Word last_mask) noexcept;
+
+/**
+ * @brief Whether all cells of a row are empty.
+ *
+ * @param kernel A supported kernel.
+ * @param words The words of a row.
+ */
+bool AllClear(Kernel kernel, std::span<const Word> words) noexcept;
+
+//! Whether all cells of a row are empty, using the best kernel.
+bool AllClear(std::span<const Word> words) noexcept;
+
+}  // namespace row_scan
\ No newline at end of file
@@ -0,0 +1,126 @@
+/**
+ * @file runner.h
+ * @brief The parallel runner of headless games.
+ *
+ * @author Chen Zhenshuo (chenzs108@outlook.com)
+ * @par GitHub
+ * https://github.com/Zhuagenborn
+ * @version 1.0
+ * @date 2023-05-04
+ */
+
+#pragma once
+
+#include "game.h"
+#include "policy.h"
+#include "pool.h"
+
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+
+//! The statistics of a finished game.
+struct GameResult {
+    std::uint64_t seed {0};
+
+    std::size_t score {0};
+
+    std::size_t line_count {0};
+
+    std::size_t piece_count {0};
+
+    std::size_t tick_count {0};
+};
+
+//! The statistics of a batch of games.
+struct RunResult {
+    //! Per-game statistics ordered by game index.
+    std::vector<GameResult> games;
+
+    std::size_t score {0};
+
+    std::size_t line_count {0};
+
+    std::size_t piece_count {0};
+
+    std::size_t tick_count {0};
+
+    std::chrono::steady_clock::duration elapsed {0};
+};
+
+/**
+ * @brief Play a started headless game with a policy until it is over.
+ *
+ * @param game A started headless game.
+ * @param policy A policy.
+ * @param max_actions_per_tick
+ * The maximum number of actions between two gravity ticks.
+ * It prevents a policy from stalling a game without descending.
+ * @param max_piece_count The number of tetrominoes after which the game stops even if it is not over.
+ */
+void PlayGame(Game& game, Policy& policy, std::size_t max_actions_per_tick,
+              std::size_t max_piece_count
+              = std::numeric_limits<std::size_t>::max()) noexcept;
+
+/**
+ * @brief A runner playing independent headless games in parallel.
+ *
+ * @details
+ * Each game owns its grid, tetromino generator and policy, so workers share no mutable state.
+ * A game and its policy are seeded with the same seed, so the result of a seed is reproducible.
+ * Totals are aggregated with atomic additions.
+ */
+class Runner {
+public:
+    /**
+     * @param width The width of grids.
+     * @param height The height of grids.
+     * @param settings Game settings. Games are always headless.
+     * @param policy_factory A factory creating a policy for each game.
+     */
+    Runner(std::size_t width, std::size_t height, GameSettings settings,
+           PolicyFactory policy_factory) noexcept;
+
+    /**
+     * @brief Set the maximum number of actions between two gravity ticks.
+     *
+     * @details
+     * It prevents a policy from stalling a game without descending.
+     */
+    Runner& SetMaxActionsPerTick(std::size_t) noexcept;
+
+    /**
+     * @brief Set the number of tetrominoes after which each game stops even if it is not over.
+     *
+     * @details
+     * It bounds the work of policies that rarely lose. By default, games are played until they are over.
+     */
+    Runner& SetMaxPieceCount(std::size_t) noexcept;
+
+    /**
+     * @brief Play games until they are over or reach the maximum number of tetrominoes.
+     *
+     * @param pool A thread pool.
+     * @param game_count The number of games.
+     * @param first_seed The seed of the first game. The seed of the game @p i is <tt>first_seed + i</tt>.
+     */
+    RunResult Run(WorkStealingPool& pool, std::size_t game_count,
+                  std::uint64_t first_seed = 0) const noexcept;
+
+private:
+    GameResult Play(std::uint64_t seed) const noexcept;
+
+    std::size_t width_;
+
+    std::size_t height_;
+
+    GameSettings settings_;
+
+    PolicyFactory policy_factory_;
+
+    std::size_t max_actions_per_tick_ {8};
+
+    std::size_t max_piece_count_ {std::numeric_limits<std::size_t>::max()};
+};
\ No newline at end of file
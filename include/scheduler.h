@@ -0,0 +1,116 @@
+/**
+ * @file scheduler.h
+ * @brief The gravity scheduler shared by games.
+ *
+ * @author Chen Zhenshuo (chenzs108@outlook.com)
+ * @par GitHub
+ * https://github.com/Zhuagenborn
+ * @version 1.0
+ * @date 2023-05-10
+ */
+
+#pragma once
+
+#include "notifier.h"
+#include "timer_wheel.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+
+class Game;
+
+/**
+ * @brief A thread running the game loops of many games.
+ *
+ * @details
+ * The next descents of all games are scheduled in one timer wheel,
+ * so thousands of games are descended by a single thread instead of one thread per game.
+ * When an action is posted to a game, the game is marked in a bitmask and the thread is woken up to execute it.
+ * Posting never waits for the thread to handle games, and the thread handles all marked games at once.
+ * Only the first post to a game since it was last handled wakes up the thread.
+ *
+ * A game uses a scheduler when it is set by @p GameSettings::SetScheduler.
+ * It is attached when it starts and detached when it stops or is destroyed, so a slot can be reused by later games.
+ * The scheduler must outlive its games.
+ */
+class GravityScheduler {
+public:
+    static constexpr std::chrono::milliseconds default_resolution {1};
+
+    /**
+     * @param capacity The maximum number of running games. Other games run their own game loops.
+     * @param resolution The resolution of descent deadlines.
+     */
+    explicit GravityScheduler(
+        std::size_t capacity,
+        std::chrono::steady_clock::duration resolution =
+            default_resolution) noexcept;
+
+    GravityScheduler(const GravityScheduler&) = delete;
+
+    GravityScheduler& operator=(const GravityScheduler&) = delete;
+
+    std::size_t GetCapacity() const noexcept;
+
+    //! Get the number of games attached to the scheduler.
+    std::size_t GetGameCount() const noexcept;
+
+    ~GravityScheduler() noexcept;
+
+private:
+    friend class Game;
+
+    static constexpr std::size_t pending_word_bits {64};
+
+    /**
+     * @brief Attach a started game and schedule its first descent.
+     *
+     * @return The slot of the game, or @p std::nullopt if the scheduler is full.
+     */
+    std::optional<std::size_t> Attach(Game&) noexcept;
+
+    /**
+     * @brief Detach a game.
+     *
+     * @details
+     * When it returns, the thread no longer uses the game.
+     */
+    void Detach(std::size_t slot) noexcept;
+
+    //! Mark a game as having pending work and wake up the thread. It can be called from any thread.
+    void Notify(std::size_t slot) noexcept;
+
+    void Loop(std::stop_token) noexcept;
+
+    //! Run the game loop of a game once and schedule its next descent.
+    void Process(std::size_t slot, std::chrono::steady_clock::time_point now) noexcept;
+
+    //! Protect the games and the timer wheel.
+    mutable std::mutex mtx_;
+
+    TimerWheel wheel_;
+
+    //! Games by slot. A detached slot is @p nullptr.
+    std::vector<Game*> games_;
+
+    std::vector<std::size_t> free_slots_;
+
+    //! The bitmask of games with pending work.
+    std::unique_ptr<std::atomic<std::uint64_t>[]> pending_;
+
+    std::size_t pending_word_count_;
+
+    //! Notified when a game is attached or marked.
+    Notifier notifier_;
+
+    std::jthread thread_;
+};
\ No newline at end of file
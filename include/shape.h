@@ -64,4 +64,8 @@ protected:
                                                                 \
     bool Filled(const Point& pos) const noexcept override {     \
         return Shape::Filled(cells, pos);                       \
+    }                                                           \
+                                                                \
+    static constexpr const auto& GetCells() noexcept {          \
+        return cells;                                           \
     }
\ No newline at end of file
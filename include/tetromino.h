@@ -25,6 +25,8 @@
 #include "rotation.h"
 #include "shape.h"
 
+#include <array>
+#include <cstdint>
 #include <iostream>
 #include <memory>
 #include <optional>
@@ -33,7 +35,54 @@
 
 namespace tetromino {
 
-enum class Type { I, J, L, O, S, T, Z };
+enum class Type : std::uint8_t { I, J, L, O, S, T, Z };
+
+inline constexpr std::size_t type_count {7};
+
+//! The number of cells a tetromino occupies.
+inline constexpr std::size_t cell_count {4};
+
+//! The maximum width and height of a tetromino.
+inline constexpr std::size_t max_size {4};
+
+/**
+ * @brief The precomputed layout of a tetromino at an angle.
+ *
+ * @details
+ * It is generated at compile time from the underlying shapes,
+ * so collision tests and rendering can read it without virtual dispatch.
+ */
+struct ShapeMask {
+    //! Whether a position relative to the top-left corner is filled.
+    constexpr bool Filled(const Point& pos) const noexcept {
+        return pos.x < width && pos.y < height && ((rows[pos.y] >> pos.x) & 1);
+    }
+
+    std::size_t width;
+
+    std::size_t height;
+
+    //! Row bitmasks from top to bottom. The bit @p i represents the column @p i.
+    std::array<std::uint8_t, max_size> rows;
+
+    //! The positions of filled cells relative to the top-left corner.
+    std::array<Point, cell_count> cells;
+
+    //! The lowest filled row of each column relative to the top.
+    std::array<std::uint8_t, max_size> bottoms;
+};
+
+//! Get the precomputed layout of a tetromino type at an angle.
+const ShapeMask& GetShapeMask(Type, Angle) noexcept;
+
+/**
+ * @brief Get the number of distinct layouts of a tetromino type.
+ *
+ * @details
+ * It is 1 for @p O, 2 for @p I, @p S and @p Z, and 4 for the others.
+ * The layout at an angle @p a is the same as the one at <tt>a % count</tt>.
+ */
+std::size_t GetRotationCount(Type) noexcept;
 
 Type GetRandomType() noexcept;
 
@@ -69,6 +118,9 @@ public:
 
     virtual tetromino::Type GetType() const noexcept = 0;
 
+    //! Get the precomputed layout of the current angle.
+    const tetromino::ShapeMask& GetShapeMask() const noexcept;
+
     //! Given an angle, get the rotated tetromino.
     virtual std::unique_ptr<Tetromino> GetTetrominoByAngle(
         Angle) const noexcept = 0;
@@ -0,0 +1,132 @@
+/**
+ * @file timer_wheel.h
+ * @brief The hierarchical timer wheel.
+ *
+ * @author Chen Zhenshuo (chenzs108@outlook.com)
+ * @par GitHub
+ * https://github.com/Zhuagenborn
+ * @version 1.0
+ * @date 2023-05-10
+ */
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <vector>
+
+
+/**
+ * @brief Timers identified by indices, expiring at absolute deadlines.
+ *
+ * @details
+ * Time is divided into ticks of a fixed resolution.
+ * Each level has 64 slots, and a slot of level @p k covers <tt>64^k</tt> ticks.
+ * A timer is linked into the slot of the lowest level covering its deadline,
+ * and moved down a level each time the current tick enters the range of its slot.
+ * So scheduling, cancelling and expiring a timer take constant time no matter how many timers there are.
+ *
+ * A timer never expires before its deadline and at most one tick after it, plus the delay of calling @p Advance.
+ *
+ * @warning
+ * It is not thread-safe.
+ */
+class TimerWheel {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr std::size_t level_count {4};
+
+    static constexpr std::size_t slot_count {64};
+
+    /**
+     * @param resolution The length of a tick.
+     * @param origin The time of the tick @p 0.
+     */
+    explicit TimerWheel(Clock::duration resolution,
+                        Clock::time_point origin = Clock::now()) noexcept;
+
+    //! Schedule a timer, or reschedule it if it is scheduled. A deadline in the past expires at the next tick.
+    void Schedule(std::size_t id, Clock::time_point deadline) noexcept;
+
+    //! Cancel a timer if it is scheduled.
+    void Cancel(std::size_t id) noexcept;
+
+    bool IsScheduled(std::size_t id) const noexcept;
+
+    //! Get the number of scheduled timers.
+    std::size_t GetSize() const noexcept;
+
+    /**
+     * @brief Get the time when @p Advance should be called next.
+     *
+     * @details
+     * It is the first tick at which a timer may expire, or earlier when timers need to be moved down a level.
+     * So it is less than one tick after the earliest deadline.
+     *
+     * @return The time, or @p std::nullopt if no timer is scheduled.
+     */
+    std::optional<Clock::time_point> GetNextWakeUpTime() const noexcept;
+
+    /**
+     * @brief Advance to a time, expiring timers in the order of their deadlines.
+     *
+     * @param expire
+     * A callback receiving the ID of each expired timer.
+     * It may schedule or cancel timers.
+     */
+    void Advance(Clock::time_point now,
+                 const std::function<void(std::size_t id)>& expire) noexcept;
+
+private:
+    static constexpr std::size_t slot_bits {6};
+
+    static constexpr std::size_t npos {SIZE_MAX};
+
+    struct Timer {
+        //! The tick of the deadline.
+        std::uint64_t tick {0};
+
+        //! The index of the slot in @p slots_, or @p npos if it is not scheduled.
+        std::size_t slot {npos};
+
+        std::size_t prev {npos};
+
+        std::size_t next {npos};
+    };
+
+    //! Get the first tick not earlier than a time.
+    std::uint64_t ToTick(Clock::time_point) const noexcept;
+
+    //! Get the first tick at which any slot is expired or moved down.
+    std::uint64_t GetNextEventTick() const noexcept;
+
+    //! Link a timer into the slot covering its deadline, which must not be earlier than the current tick.
+    void Link(std::size_t id) noexcept;
+
+    void Unlink(std::size_t id) noexcept;
+
+    //! Advance by one tick.
+    void Step(const std::function<void(std::size_t id)>& expire) noexcept;
+
+    Clock::duration resolution_;
+
+    Clock::time_point origin_;
+
+    //! The last tick that has been processed.
+    std::uint64_t current_ {0};
+
+    std::size_t size_ {0};
+
+    std::vector<Timer> timers_;
+
+    //! The first timer in each slot, level by level.
+    std::array<std::size_t, level_count * slot_count> slots_;
+
+    //! The bitmask of non-empty slots of each level.
+    std::array<std::uint64_t, level_count> occupied_ {};
+};
\ No newline at end of file
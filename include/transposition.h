@@ -0,0 +1,71 @@
+/**
+ * @file transposition.h
+ * @brief The lock-free transposition table.
+ *
+ * @author Chen Zhenshuo (chenzs108@outlook.com)
+ * @par GitHub
+ * https://github.com/Zhuagenborn
+ * @version 1.0
+ * @date 2023-05-09
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+
+/**
+ * @brief A fixed-size cache mapping board hashes to evaluations.
+ *
+ * @details
+ * It is a direct-mapped table whose new entries always replace old ones.
+ * Each entry stores its evaluation and the XOR of its hash and evaluation in two atomic words.
+ * A reader racing with a writer may see the words of different entries,
+ * but then the XOR no longer matches the hash and the entry is treated as missing.
+ * So threads can share a table without locks.
+ */
+class TranspositionTable {
+public:
+    /**
+     * @brief Create a table.
+     *
+     * @param capacity The number of entries. It is rounded up to a power of 2.
+     */
+    explicit TranspositionTable(std::size_t capacity) noexcept;
+
+    std::size_t GetCapacity() const noexcept;
+
+    //! Find the evaluation of a hash.
+    std::optional<double> Find(std::uint64_t hash) const noexcept;
+
+    /**
+     * @brief Store the evaluation of a hash, replacing the entry in its slot.
+     *
+     * @param hash A hash.
+     * @param value An evaluation other than NaN.
+     */
+    void Insert(std::uint64_t hash, double value) noexcept;
+
+    //! Remove all entries. It must not be called concurrently with other methods.
+    void Clear() noexcept;
+
+private:
+    struct Entry {
+        //! The XOR of the hash and @p data.
+        std::atomic<std::uint64_t> check;
+
+        //! The bits of the evaluation.
+        std::atomic<std::uint64_t> data;
+    };
+
+    //! The data of empty entries. It is a NaN, which is never stored.
+    static constexpr std::uint64_t empty_data_ {~std::uint64_t {0}};
+
+    std::size_t mask_;
+
+    std::unique_ptr<Entry[]> entries_;
+};
\ No newline at end of file
@@ -20,11 +20,109 @@ public:
         return height;
     }
 
+    std::size_t GetGameCount() const noexcept {
+        std::size_t count {0};
+        cmdl_(game_count_opt_.data()) >> count;
+        return count;
+    }
+
+    std::size_t GetThreadCount() const noexcept {
+        std::size_t count {0};
+        cmdl_(thread_count_opt_.data()) >> count;
+        return count;
+    }
+
+    std::uint64_t GetSeed() const noexcept {
+        std::uint64_t seed {0};
+        cmdl_(seed_opt_.data()) >> seed;
+        return seed;
+    }
+
+    bool IsScaling() const noexcept {
+        return cmdl_[scaling_opt_.data()];
+    }
+
+    std::string GetRecordPath() const noexcept {
+        std::string path;
+        cmdl_(record_opt_.data()) >> path;
+        return path;
+    }
+
+    std::string GetReplayPath() const noexcept {
+        std::string path;
+        cmdl_(replay_opt_.data()) >> path;
+        return path;
+    }
+
+    bool IsAutoplay() const noexcept {
+        return cmdl_[autoplay_opt_.data()];
+    }
+
+    bool IsHeadless() const noexcept {
+        return cmdl_[headless_opt_.data()];
+    }
+
+    std::size_t GetNextCount() const noexcept {
+        std::size_t count {0};
+        cmdl_(next_count_opt_.data()) >> count;
+        return count;
+    }
+
+    std::size_t GetBeamWidth() const noexcept {
+        std::size_t width {0};
+        cmdl_(beam_width_opt_.data()) >> width;
+        return width;
+    }
+
+    std::size_t GetBudget() const noexcept {
+        std::size_t budget {0};
+        cmdl_(budget_opt_.data()) >> budget;
+        return budget;
+    }
+
+    std::size_t GetPieceCount() const noexcept {
+        std::size_t count {0};
+        cmdl_(piece_count_opt_.data()) >> count;
+        return count;
+    }
+
+    std::string GetLatencyPath() const noexcept {
+        std::string path;
+        cmdl_(latency_opt_.data()) >> path;
+        return path;
+    }
+
 private:
     static constexpr std::string_view width_opt_ {"x"};
 
     static constexpr std::string_view height_opt_ {"y"};
 
+    static constexpr std::string_view game_count_opt_ {"games"};
+
+    static constexpr std::string_view thread_count_opt_ {"threads"};
+
+    static constexpr std::string_view seed_opt_ {"seed"};
+
+    static constexpr std::string_view scaling_opt_ {"scaling"};
+
+    static constexpr std::string_view record_opt_ {"record"};
+
+    static constexpr std::string_view replay_opt_ {"replay"};
+
+    static constexpr std::string_view autoplay_opt_ {"ai"};
+
+    static constexpr std::string_view headless_opt_ {"headless"};
+
+    static constexpr std::string_view next_count_opt_ {"next"};
+
+    static constexpr std::string_view beam_width_opt_ {"beam"};
+
+    static constexpr std::string_view budget_opt_ {"budget"};
+
+    static constexpr std::string_view piece_count_opt_ {"pieces"};
+
+    static constexpr std::string_view latency_opt_ {"latency"};
+
     argh::parser cmdl_;
 };
 
@@ -42,4 +140,56 @@ std::size_t CmdArgs::GetWidth() const noexcept {
 
 std::size_t CmdArgs::GetHeight() const noexcept {
     return impl_->GetHeight();
+}
+
+std::size_t CmdArgs::GetGameCount() const noexcept {
+    return impl_->GetGameCount();
+}
+
+std::size_t CmdArgs::GetThreadCount() const noexcept {
+    return impl_->GetThreadCount();
+}
+
+std::uint64_t CmdArgs::GetSeed() const noexcept {
+    return impl_->GetSeed();
+}
+
+bool CmdArgs::IsScaling() const noexcept {
+    return impl_->IsScaling();
+}
+
+std::string CmdArgs::GetRecordPath() const noexcept {
+    return impl_->GetRecordPath();
+}
+
+std::string CmdArgs::GetReplayPath() const noexcept {
+    return impl_->GetReplayPath();
+}
+
+bool CmdArgs::IsAutoplay() const noexcept {
+    return impl_->IsAutoplay();
+}
+
+bool CmdArgs::IsHeadless() const noexcept {
+    return impl_->IsHeadless();
+}
+
+std::size_t CmdArgs::GetNextCount() const noexcept {
+    return impl_->GetNextCount();
+}
+
+std::size_t CmdArgs::GetBeamWidth() const noexcept {
+    return impl_->GetBeamWidth();
+}
+
+std::size_t CmdArgs::GetBudget() const noexcept {
+    return impl_->GetBudget();
+}
+
+std::size_t CmdArgs::GetPieceCount() const noexcept {
+    return impl_->GetPieceCount();
+}
+
+std::string CmdArgs::GetLatencyPath() const noexcept {
+    return impl_->GetLatencyPath();
 }
\ No newline at end of file
@@ -7,12 +7,10 @@
 
 
 Color GetRandomColor() noexcept {
-    using ColorInt = std::underlying_type_t<Color>;
-    static std::default_random_engine eng {static_cast<unsigned>(
+    thread_local std::default_random_engine eng {static_cast<unsigned>(
         std::chrono::system_clock::now().time_since_epoch().count())};
-    static std::uniform_int_distribution dist(
-        static_cast<ColorInt>(Color::Non) + 1,
-        static_cast<ColorInt>(Color::White));
+    thread_local std::uniform_int_distribution dist(
+        static_cast<int>(Color::Non) + 1, static_cast<int>(Color::White));
     return static_cast<Color>(dist(eng));
 }
 
@@ -1,15 +1,26 @@
 #include "controller.h"
+#include "latency.h"
 #include "ui/grid_board.h"
 #include "ui/next_tetromino_board.h"
 #include "ui/score_board.h"
 
+#include <chrono>
+#include <deque>
+#include <iomanip>
+#include <utility>
+
 
 class Controller::Impl {
 public:
-    Impl(std::unique_ptr<Game> game) noexcept : game_ {std::move(game)} {
+    Impl(std::unique_ptr<Game> game, std::unique_ptr<Policy> player) noexcept
+        :
+        game_ {std::move(game)}, player_ {std::move(player)} {
+        const auto descend_time {game_->GetSettings().GetDescendTime()};
+        input_time_out_ = player_ ? descend_time / player_actions_per_descent
+                                  : descend_time;
+        const auto grid {game_->GetGrid()};
         grid_board_ = std::make_unique<ui::GridBoard>(
-            Point {0, 0}, game_->GetGrid(),
-            game_->GetSettings().GetDescendTime());
+            Point {0, 0}, grid->GetWidth(), grid->GetHeight(), input_time_out_);
 
         const Point score_board_pos {0, grid_board_->GetHeight()};
         score_board_ = std::make_unique<ui::ScoreBoard>(score_board_pos,
@@ -21,19 +32,42 @@ public:
     }
 
     void Refresh() noexcept {
-        score_board_->Update(game_->GetScore());
-        grid_board_->Update();
-
-        if (const auto next_tetrominoes {game_->GetNextTetrominoes()};
-            !next_tetrominoes.empty()) {
-            next_tetromino_board_->Update(next_tetrominoes.front());
+        const auto begin {std::chrono::steady_clock::now()};
+        // Draw one snapshot, so the boards always agree with each other.
+        const auto state {game_->GetState()};
+        score_board_->Update(state->score);
+        grid_board_->Update(state->grid);
+
+        if (!state->next_tetrominoes.empty()) {
+            next_tetromino_board_->Update(state->next_tetrominoes.front());
         } else {
             next_tetromino_board_->Clear();
         }
+
+        const auto end {std::chrono::steady_clock::now()};
+        frame_time_.Record(end - begin);
+        // The frame shows the inputs whose actions have been executed.
+        while (!pending_inputs_.empty()
+               && pending_inputs_.front().action_count <= state->action_count) {
+            input_to_frame_latency_.Record(end - pending_inputs_.front().time);
+            pending_inputs_.pop_front();
+        }
     }
 
     void Input() noexcept {
-        switch (grid_board_->Input()) {
+        // Actions posted to the game loop are executed asynchronously.
+        // Poll until they are drawn instead of waiting for the next key.
+        grid_board_->SetInputTimeOut(pending_inputs_.empty()
+                                         ? input_time_out_
+                                         : pending_input_poll_time);
+        const auto key {grid_board_->Input()};
+        input_time_ = std::chrono::steady_clock::now();
+        if (player_) {
+            action_ = player_->Decide(*game_);
+            return;
+        }
+
+        switch (key) {
             case 'w':
             case KEY_UP: {
                 action_ = Action::RotateLeft;
@@ -44,6 +78,10 @@ public:
                 action_ = Action::Descend;
                 break;
             }
+            case ' ': {
+                action_ = Action::HardDrop;
+                break;
+            }
             case 'a':
             case KEY_LEFT: {
                 action_ = Action::MoveToLeft;
@@ -62,20 +100,106 @@ public:
     }
 
     void Update() noexcept {
-        game_->Act(action_);
+        if (!game_->GetSettings().IsHeadless()) {
+            // A full queue drops the key press rather than blocking the user interface.
+            if (action_ != Action::Non && game_->Post(action_)) {
+                OnActionSent();
+            }
+
+            return;
+        }
+
+        if (game_->Act(action_) != ActionResult::GameOver
+            && action_ != Action::Non) {
+            OnActionSent();
+        }
+
+        if (const auto now {std::chrono::steady_clock::now()};
+            now - last_descent_ >= game_->GetDescendTime()) {
+            game_->Tick();
+            last_descent_ = now;
+        }
     }
 
     bool IsOver() const noexcept {
         return game_->IsOver();
     }
 
+    void PrintLatency(std::ostream& os) const noexcept {
+        const auto to_microseconds {[](const LatencyHistogram::Duration time) {
+            return std::chrono::duration<double, std::micro> {time}.count();
+        }};
+
+        os << std::setw(16) << "Latency (us)" << std::setw(10) << "Count"
+           << std::setw(12) << "p50" << std::setw(12) << "p99"
+           << std::setw(12) << "p999" << std::setw(12) << "Max" << '\n';
+        for (const auto& [name, histogram] :
+             {std::pair {"Input to action", &input_latency_},
+              std::pair {"Input to frame", &input_to_frame_latency_},
+              std::pair {"Frame time", &frame_time_}}) {
+            os << std::setw(16) << name << std::setw(10)
+               << histogram->GetCount() << std::fixed << std::setprecision(1)
+               << std::setw(12) << to_microseconds(histogram->GetPercentile(50))
+               << std::setw(12) << to_microseconds(histogram->GetPercentile(99))
+               << std::setw(12)
+               << to_microseconds(histogram->GetPercentile(99.9))
+               << std::setw(12) << to_microseconds(histogram->GetMax())
+               << '\n';
+        }
+
+        os << std::flush;
+    }
+
 private:
+    //! An input whose action has been sent to the game but may not be drawn yet.
+    struct PendingInput {
+        //! The number of actions the game has executed once it executes this one.
+        std::size_t action_count;
+
+        std::chrono::steady_clock::time_point time;
+    };
+
+    void OnActionSent() noexcept {
+        const auto now {std::chrono::steady_clock::now()};
+        input_latency_.Record(now - input_time_);
+        pending_inputs_.push_back({++sent_action_count_, input_time_});
+    }
+
     static constexpr std::size_t score_board_width {10};
 
+    //! The number of times a player acts between two descents.
+    static constexpr int player_actions_per_descent {8};
+
+    //! How long to wait for a key while posted actions have not been drawn.
+    static constexpr std::chrono::milliseconds pending_input_poll_time {1};
+
     std::unique_ptr<Game> game_;
 
+    std::unique_ptr<Policy> player_;
+
+    std::chrono::steady_clock::duration input_time_out_;
+
+    std::chrono::steady_clock::time_point last_descent_ {
+        std::chrono::steady_clock::now()};
+
     Action action_ {Action::Non};
 
+    //! The time when the last key was received or the player decided.
+    std::chrono::steady_clock::time_point input_time_;
+
+    std::size_t sent_action_count_ {0};
+
+    std::deque<PendingInput> pending_inputs_;
+
+    //! From receiving a key to executing or posting its action.
+    LatencyHistogram input_latency_;
+
+    //! From receiving a key to drawing the first frame showing its action.
+    LatencyHistogram input_to_frame_latency_;
+
+    //! The time of drawing and refreshing all boards.
+    LatencyHistogram frame_time_;
+
     std::unique_ptr<ui::GridBoard> grid_board_;
 
     std::unique_ptr<ui::ScoreBoard> score_board_;
@@ -93,8 +217,9 @@ Controller::Initializer::~Initializer() noexcept {
     endwin();
 }
 
-Controller::Controller(std::unique_ptr<Game> game) noexcept :
-    impl_ {std::make_unique<Impl>(std::move(game))} {}
+Controller::Controller(std::unique_ptr<Game> game,
+                       std::unique_ptr<Policy> player) noexcept :
+    impl_ {std::make_unique<Impl>(std::move(game), std::move(player))} {}
 
 Controller::~Controller() noexcept = default;
 
@@ -112,4 +237,8 @@ void Controller::Update() noexcept {
 
 bool Controller::IsOver() const noexcept {
     return impl_->IsOver();
+}
+
+void Controller::PrintLatency(std::ostream& os) const noexcept {
+    impl_->PrintLatency(os);
 }
\ No newline at end of file
@@ -61,6 +61,9 @@ struct CellSymbols {
 
     chtype filled;
 
+    //! The symbol showing where the current tetromino will land.
+    chtype ghost;
+
     /**
      * @brief
      * The number of columns per cell on the terminal.
@@ -69,6 +72,6 @@ struct CellSymbols {
     std::size_t width;
 };
 
-inline constexpr CellSymbols cell_sym {' ', 'O', 2};
+inline constexpr CellSymbols cell_sym {' ', 'O', '.', 2};
 
 }  // namespace ui
\ No newline at end of file
@@ -15,24 +15,27 @@
 #include "color_env.h"
 #include "grid.h"
 
+#include <algorithm>
 #include <chrono>
-#include <memory>
+#include <optional>
+#include <vector>
 
 
 namespace ui {
 
 class GridBoard : public Board {
 public:
-    GridBoard(const Point& pos, std::shared_ptr<const Grid> grid,
+    GridBoard(const Point& pos, const std::size_t grid_width,
+              const std::size_t grid_height,
               const std::chrono::steady_clock::duration input_time_out) noexcept
         :
-        grid_ {std::move(grid)} {
+        grid_width_ {grid_width}, grid_height_ {grid_height} {
         assert(IsValidPosition(pos));
-        assert(grid_->GetWidth() <= std::numeric_limits<int>::max());
-        assert(grid_->GetHeight() <= std::numeric_limits<int>::max());
+        assert(grid_width_ <= std::numeric_limits<int>::max());
+        assert(grid_height_ <= std::numeric_limits<int>::max());
 
-        board_ = newwin(grid_->GetHeight() + 2,
-                        grid_->GetWidth() * cell_sym.width + 2, pos.y, pos.x);
+        board_ = newwin(grid_height_ + 2, grid_width_ * cell_sym.width + 2,
+                        pos.y, pos.x);
         InitSettings(input_time_out);
         box(board_, 0, 0);
         Clear();
@@ -54,33 +57,60 @@ public:
         return wgetch(board_);
     }
 
-    void Update() noexcept {
-        for (std::size_t x {0}; x < grid_->GetWidth(); ++x) {
-            for (std::size_t y {0}; y < grid_->GetHeight(); ++y) {
-                if (grid_->Filled({x, y})) {
-                    const ColorEnvironment env {board_,
-                                                grid_->GetColor({x, y})};
-                    mvwaddch(board_, y + 1, x * cell_sym.width + 1,
-                             cell_sym.filled);
-                } else {
-                    const ColorEnvironment env {board_, Color::Non};
-                    mvwaddch(board_, y + 1, x * cell_sym.width + 1,
-                             cell_sym.blank);
-                }
+    //! Set how long @p Input waits for a key.
+    void SetInputTimeOut(
+        const std::chrono::steady_clock::duration time_out) noexcept {
+        const auto milliseconds {
+            std::chrono::duration_cast<std::chrono::milliseconds>(time_out)
+                .count()};
+        assert(milliseconds <= std::numeric_limits<int>::max());
+        wtimeout(board_, milliseconds);
+    }
+
+    /**
+     * @brief Draw a grid of the same size as the board.
+     *
+     * @details
+     * Only the rows that have changed since the last drawn grid are redrawn.
+     */
+    void Update(const Grid& grid) noexcept {
+        assert(grid.GetWidth() == grid_width_
+               && grid.GetHeight() == grid_height_);
+        const auto ghost {GetGhost(grid)};
+        auto dirty {last_frame_.has_value()
+                        ? grid.GetDirtyRows(*last_frame_)
+                        : std::vector<bool>(grid_height_, true)};
+        // The ghost can move without the current tetromino, e.g. when lines below it are cleared.
+        if (ghost != last_ghost_) {
+            MarkRows(dirty, ghost);
+            MarkRows(dirty, last_ghost_);
+        }
+
+        auto changed {false};
+        for (std::size_t y {0}; y < grid_height_; ++y) {
+            if (dirty[y]) {
+                DrawRow(grid, ghost, y);
+                changed = true;
             }
         }
 
-        Refresh();
+        last_frame_.emplace(grid.Fork());
+        last_ghost_ = ghost;
+        if (changed) {
+            Refresh();
+        }
     }
 
     void Clear() noexcept {
         const ColorEnvironment env {board_, Color::Non};
-        for (std::size_t x {0}; x < grid_->GetWidth(); ++x) {
-            for (std::size_t y {0}; y < grid_->GetHeight(); ++y) {
+        for (std::size_t y {0}; y < grid_height_; ++y) {
+            for (std::size_t x {0}; x < grid_width_; ++x) {
                 mvwaddch(board_, y + 1, x * cell_sym.width + 1, cell_sym.blank);
             }
         }
 
+        last_frame_.reset();
+        last_ghost_.reset();
         Refresh();
     }
 
@@ -91,25 +121,88 @@ public:
 private:
     void InitSettings(
         const std::chrono::steady_clock::duration input_time_out) noexcept {
-        const auto milliseconds {
-            std::chrono::duration_cast<std::chrono::milliseconds>(
-                input_time_out)
-                .count()};
-        assert(milliseconds <= std::numeric_limits<int>::max());
         noecho();
         cbreak();
         curs_set(0);
         keypad(board_, true);
-        wtimeout(board_, milliseconds);
+        SetInputTimeOut(input_time_out);
     }
 
     void Refresh() noexcept {
         wrefresh(board_);
     }
 
+    //! Get the current tetromino moved to where it will land.
+    static std::optional<Piece> GetGhost(const Grid& grid) noexcept {
+        auto ghost {grid.GetTetromino()};
+        if (ghost.has_value()) {
+            ghost->SetPosition(grid.GetDropPosition(
+                ghost->GetType(), ghost->GetAngle(), ghost->GetPosition()));
+        }
+
+        return ghost;
+    }
+
+    struct Cell {
+        chtype symbol;
+
+        Color color;
+    };
+
+    //! Get how a cell is drawn, including the ghost.
+    static Cell GetCell(const Grid& grid, const std::optional<Piece>& ghost,
+                        const Point& pos) noexcept {
+        if (grid.Filled(pos)) {
+            return {cell_sym.filled, grid.GetColor(pos)};
+        } else if (ghost.has_value() && ghost->GetPosition().x <= pos.x
+                   && ghost->GetPosition().y <= pos.y
+                   && ghost->Filled({pos.x - ghost->GetPosition().x,
+                                     pos.y - ghost->GetPosition().y})) {
+            return {cell_sym.ghost, ghost->GetColor()};
+        } else {
+            return {cell_sym.blank, Color::Non};
+        }
+    }
+
+    //! Mark the rows covered by a piece as dirty.
+    void MarkRows(std::vector<bool>& dirty,
+                  const std::optional<Piece>& piece) const noexcept {
+        if (piece.has_value()) {
+            const auto top {piece->GetPosition().y};
+            const auto bottom {
+                std::min(top + piece->GetHeight(), grid_height_)};
+            std::fill(dirty.begin() + top, dirty.begin() + bottom, true);
+        }
+    }
+
+    //! Draw a row, changing the color attribute once per run of cells in the same color.
+    void DrawRow(const Grid& grid, const std::optional<Piece>& ghost,
+                 const std::size_t y) noexcept {
+        std::size_t x {0};
+        auto cell {GetCell(grid, ghost, {x, y})};
+        while (x < grid_width_) {
+            const auto color {cell.color};
+            const ColorEnvironment env {board_, color};
+            do {
+                mvwaddch(board_, y + 1, x * cell_sym.width + 1, cell.symbol);
+                if (++x < grid_width_) {
+                    cell = GetCell(grid, ghost, {x, y});
+                }
+            } while (x < grid_width_ && cell.color == color);
+        }
+    }
+
     WINDOW* board_;
 
-    std::shared_ptr<const Grid> grid_;
+    std::size_t grid_width_;
+
+    std::size_t grid_height_;
+
+    //! A fork of the last drawn grid.
+    std::optional<Grid> last_frame_;
+
+    //! The ghost of the last drawn grid.
+    std::optional<Piece> last_ghost_;
 };
 
 }  // namespace ui
\ No newline at end of file
@@ -13,7 +13,7 @@
 
 #include "board.h"
 #include "color_env.h"
-#include "tetromino.h"
+#include "piece.h"
 
 
 namespace ui {
@@ -27,12 +27,13 @@ public:
         Clear();
     }
 
-    void Update(const Tetromino& tetromino) noexcept {
+    void Update(const Piece& tetromino) noexcept {
         Clear();
         const auto color {tetromino.GetColor()};
-        for (std::size_t x {0}; x < tetromino.GetWidth(); ++x) {
-            for (std::size_t y {0}; y < tetromino.GetHeight(); ++y) {
-                if (tetromino.Filled({x, y})) {
+        const auto& mask {tetromino.GetShapeMask()};
+        for (std::size_t x {0}; x < mask.width; ++x) {
+            for (std::size_t y {0}; y < mask.height; ++y) {
+                if (mask.Filled({x, y})) {
                     const ColorEnvironment env {board_, color};
                     mvwaddch(board_, y + 1, x * cell_sym.width + 1,
                              cell_sym.filled);
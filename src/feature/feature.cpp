@@ -0,0 +1,186 @@
+#include "feature.h"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+
+
+namespace {
+
+//! Call a function with the index of each set bit of a word.
+template <typename Func>
+void ForEachBit(Grid::RowMask bits, const std::size_t base,
+                Func&& func) noexcept {
+    while (bits != 0) {
+        func(base + std::countr_zero(bits));
+        bits &= bits - 1;
+    }
+}
+
+}  // namespace
+
+std::span<const Grid::RowMask> FeatureExtractor::GetRow(
+    const Grid& grid, const std::size_t y,
+    const std::optional<Piece>& placed) noexcept {
+    const auto row {grid.GetRowMask(y)};
+    if (!placed.has_value()) {
+        return row;
+    }
+
+    const auto& mask {placed->GetShapeMask()};
+    const auto pos {placed->GetPosition()};
+    if (y < pos.y || y >= pos.y + mask.height) {
+        return row;
+    }
+
+    std::ranges::copy(row, merged_.begin());
+    const RowMask bits {mask.rows[y - pos.y]};
+    const auto word {pos.x / Grid::row_mask_bits};
+    const auto shift {pos.x % Grid::row_mask_bits};
+    merged_[word] |= bits << shift;
+    if (shift != 0 && word + 1 < merged_.size()) {
+        merged_[word + 1] |= bits >> (Grid::row_mask_bits - shift);
+    }
+
+    return merged_;
+}
+
+BoardFeatures FeatureExtractor::Extract(
+    const Grid& grid, const std::optional<Piece> placed) noexcept {
+    const auto width {grid.GetWidth()};
+    const auto height {grid.GetHeight()};
+    const auto words {grid.GetRowWordCount()};
+    assert(!placed.has_value()
+           || (placed->GetPosition().x + placed->GetShapeMask().width <= width
+               && placed->GetPosition().y + placed->GetShapeMask().height
+                      <= height));
+
+    const auto last_word_bits {width - (words - 1) * Grid::row_mask_bits};
+    const auto last_word_mask {last_word_bits == Grid::row_mask_bits
+                                   ? ~RowMask {0}
+                                   : (RowMask {1} << last_word_bits) - 1};
+    // The right wall seen from the last column.
+    const auto right_wall {RowMask {1} << (last_word_bits - 1)};
+
+    covered_.assign(words, 0);
+    above_.assign(words, 0);
+    in_wells_.assign(words, 0);
+    merged_.resize(words);
+    heights_.assign(width, 0);
+    well_depths_.assign(width, 0);
+
+    BoardFeatures features {};
+    auto covered {false};
+    for (std::size_t y {0}; y < height; ++y) {
+        const auto row {GetRow(grid, y, placed)};
+        if (!covered) {
+            // Empty rows above the highest column only have transitions to both walls.
+            if (std::ranges::all_of(
+                    row, [](const RowMask word) { return word == 0; })) {
+                features.row_transitions += 2;
+                continue;
+            }
+
+            covered = true;
+        }
+
+        auto full {true};
+        for (std::size_t i {0}; i < words; ++i) {
+            const auto last {i + 1 == words};
+            const auto valid {last ? last_word_mask : ~RowMask {0}};
+            const auto base {i * Grid::row_mask_bits};
+            const auto cells {row[i]};
+            const auto empty {~cells & valid};
+
+            // The bit i of each neighbor mask is the cell to the left or right of the column i.
+            const auto left {
+                (cells << 1)
+                | (i == 0 ? RowMask {1}
+                          : row[i - 1] >> (Grid::row_mask_bits - 1))};
+            const auto right {
+                (cells >> 1)
+                | (last ? right_wall
+                        : row[i + 1] << (Grid::row_mask_bits - 1))};
+
+            features.row_transitions += std::popcount((cells ^ left) & valid);
+            if (last && (cells & right_wall) == 0) {
+                ++features.row_transitions;
+            }
+
+            features.column_transitions +=
+                std::popcount((cells ^ above_[i]) & valid);
+            features.holes += std::popcount(empty & covered_[i]);
+
+            const auto surface {cells & ~covered_[i]};
+            ForEachBit(surface, base,
+                       [&](const std::size_t x) { heights_[x] = height - y; });
+
+            const auto wells {empty & ~covered_[i] & left & right};
+            ForEachBit(in_wells_[i] & ~wells, base,
+                       [&](const std::size_t x) { well_depths_[x] = 0; });
+            ForEachBit(wells, base, [&](const std::size_t x) {
+                features.wells += ++well_depths_[x];
+            });
+
+            full = full && empty == 0;
+            covered_[i] |= cells;
+            above_[i] = cells;
+            in_wells_[i] = wells;
+        }
+
+        if (full) {
+            ++features.completed_lines;
+        }
+    }
+
+    // The floor counts as filled.
+    for (std::size_t i {0}; i < words; ++i) {
+        const auto valid {i + 1 == words ? last_word_mask : ~RowMask {0}};
+        features.column_transitions += std::popcount(~above_[i] & valid);
+    }
+
+    for (std::size_t x {0}; x < width; ++x) {
+        features.aggregate_height += heights_[x];
+        features.max_height = std::max(features.max_height, heights_[x]);
+        if (x > 0) {
+            features.bumpiness += heights_[x] > heights_[x - 1]
+                                      ? heights_[x] - heights_[x - 1]
+                                      : heights_[x - 1] - heights_[x];
+        }
+    }
+
+    return features;
+}
+
+void FeatureExtractor::Extract(
+    const std::span<const Grid> grids,
+    const std::span<BoardFeatures> features) noexcept {
+    assert(grids.size() == features.size());
+    std::ranges::transform(grids, features.begin(), [this](const Grid& grid) {
+        return Extract(grid);
+    });
+}
+
+std::vector<BoardFeatures> FeatureExtractor::Extract(
+    const std::span<const Grid> grids) noexcept {
+    std::vector<BoardFeatures> features(grids.size());
+    Extract(grids, features);
+    return features;
+}
+
+double Evaluate(const BoardFeatures& features,
+                const FeatureWeights& weights) noexcept {
+    return weights.aggregate_height * features.aggregate_height
+           + weights.max_height * features.max_height
+           + weights.holes * features.holes
+           + weights.bumpiness * features.bumpiness
+           + weights.row_transitions * features.row_transitions
+           + weights.column_transitions * features.column_transitions
+           + weights.wells * features.wells
+           + weights.completed_lines * features.completed_lines;
+}
+
+BoardFeatures ExtractFeatures(const Grid& grid,
+                              const std::optional<Piece> placed) noexcept {
+    return FeatureExtractor {}.Extract(grid, placed);
+}
\ No newline at end of file
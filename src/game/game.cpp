@@ -1,11 +1,13 @@
 #include "game.h"
+#include "scheduler.h"
 
 #include <algorithm>
 #include <cassert>
+#include <random>
 
 
 GameSettings& GameSettings::SetNextCount(const std::size_t count) noexcept {
-    next_count_ = std::max<decltype(next_count_)>(1, count);
+    next_count_ = std::clamp<decltype(next_count_)>(count, 1, max_next_count);
     return *this;
 }
 
@@ -15,12 +17,69 @@ GameSettings& GameSettings::SetDescendTime(
     return *this;
 }
 
+GameSettings& GameSettings::SetHeadless(const bool headless) noexcept {
+    headless_ = headless;
+    return *this;
+}
+
+GameSettings& GameSettings::SetSeed(const std::uint64_t seed) noexcept {
+    seed_ = seed;
+    return *this;
+}
+
+GameSettings& GameSettings::SetScheduler(
+    std::shared_ptr<GravityScheduler> scheduler) noexcept {
+    scheduler_ = std::move(scheduler);
+    return *this;
+}
+
+GameSettings& GameSettings::SetRandomizer(const Randomizer randomizer) noexcept {
+    assert(randomizer != Randomizer::Custom);
+    randomizer_ = randomizer;
+    generator_ = [randomizer](const std::uint64_t seed) {
+        return CreateGenerator(randomizer, seed);
+    };
+
+    return *this;
+}
+
+GameSettings& GameSettings::SetGenerator(
+    PieceGeneratorFactory generator) noexcept {
+    assert(generator);
+    randomizer_ = Randomizer::Custom;
+    generator_ = std::move(generator);
+    return *this;
+}
+
 Game::Game(std::shared_ptr<Grid> grid, GameSettings settings) noexcept :
-    grid_ {std::move(grid)}, settings_ {std::move(settings)} {}
+    scheduler_ {settings.GetScheduler()},
+    descend_time_ {settings.GetDescendTime()},
+    grid_ {std::move(grid)},
+    settings_ {std::move(settings)} {
+    if (!settings_.IsHeadless()) {
+        // Readers can load a state before the game starts.
+        Publish();
+    }
+}
 
 std::size_t Game::GetScore() const noexcept {
-    const std::lock_guard lock {mtx_};
-    return score_;
+    return settings_.IsHeadless() ? score_ : GetState()->score;
+}
+
+std::size_t Game::GetLineCount() const noexcept {
+    return settings_.IsHeadless() ? line_count_ : GetState()->line_count;
+}
+
+std::uint64_t Game::GetSeed() const noexcept {
+    return seed_;
+}
+
+std::size_t Game::GetTickCount() const noexcept {
+    return settings_.IsHeadless() ? tick_count_ : GetState()->tick_count;
+}
+
+std::size_t Game::GetPieceCount() const noexcept {
+    return settings_.IsHeadless() ? piece_count_ : GetState()->piece_count;
 }
 
 std::shared_ptr<const Grid> Game::GetGrid() const noexcept {
@@ -28,9 +87,7 @@ std::shared_ptr<const Grid> Game::GetGrid() const noexcept {
 }
 
 Game::~Game() noexcept {
-    if (descend_loop_) {
-        descend_loop_->join();
-    }
+    StopLoop();
 }
 
 const GameSettings& Game::GetSettings() const noexcept {
@@ -38,33 +95,225 @@ const GameSettings& Game::GetSettings() const noexcept {
 }
 
 bool Game::IsOver() const noexcept {
-    const std::lock_guard lock {mtx_};
-    return !running_;
+    return settings_.IsHeadless() ? !running_ : GetState()->over;
 }
 
 void Game::Start() noexcept {
-    assert(!descend_loop_);
+    StopLoop();
+    // Discard the actions posted to the last game loop.
+    while (actions_.TryPop().has_value()) {
+    }
+
+    notifier_.Reset();
+
     grid_->Reset();
     score_ = 0;
+    line_count_ = 0;
+    tick_count_ = 0;
+    piece_count_ = 0;
+    action_count_ = 0;
+    seed_ = settings_.GetSeed().value_or(
+        std::random_device {}() ^ static_cast<std::uint64_t>(
+            std::chrono::steady_clock::now().time_since_epoch().count()));
+    generator_ = settings_.GetGenerator()(seed_);
+    assert(generator_);
+    next_tetrominoes_.Clear();
     running_ = true;
-    GenerateNextTetrominoes(settings_.GetNextCount());
     const auto pushed {PushNextTetromino()};
     assert(pushed);
 
-    descend_loop_ = std::make_unique<std::thread>([this]() {
-        while (!IsOver()) {
-            Act(Action::Descend);
-            std::this_thread::sleep_for(settings_.GetDescendTime());
+    if (!settings_.IsHeadless()) {
+        scheduled_descend_time_ = GetDescendTime();
+        next_descent_ =
+            std::chrono::steady_clock::now() + scheduled_descend_time_;
+        Publish();
+        const auto slot {scheduler_ ? scheduler_->Attach(*this)
+                                    : std::nullopt};
+        if (slot.has_value()) {
+            scheduler_slot_.store(*slot);
+            // Actions posted before the slot was stored only notified the game itself.
+            scheduler_->Notify(*slot);
+        } else {
+            game_loop_ = std::jthread {
+                [this](const std::stop_token token) { Loop(token); }};
         }
-    });
+    }
+}
+
+void Game::Stop() noexcept {
+    StopLoop();
+    if (running_) {
+        running_ = false;
+        if (!settings_.IsHeadless()) {
+            Publish();
+        }
+    }
+}
+
+void Game::StopLoop() noexcept {
+    if (const auto slot {scheduler_slot_.exchange(no_slot)}; slot != no_slot) {
+        scheduler_->Detach(slot);
+    } else if (game_loop_.joinable()) {
+        game_loop_.request_stop();
+        game_loop_.join();
+    } else {
+        return;
+    }
+
+    if (const auto listener {new_action_listener_.exchange(nullptr)}) {
+        action_listener_ = std::move(*listener);
+    }
+}
+
+void Game::Loop(const std::stop_token token) noexcept {
+    auto deadline {next_descent_};
+    while (true) {
+        // A stop request wakes up the loop immediately.
+        notifier_.WaitUntil(deadline, token);
+        if (token.stop_requested()) {
+            return;
+        }
+
+        if (const auto next_descent {
+                Process(std::chrono::steady_clock::now())}) {
+            deadline = *next_descent;
+        } else {
+            return;
+        }
+    }
+}
+
+std::optional<std::chrono::steady_clock::time_point> Game::Process(
+    const std::chrono::steady_clock::time_point now) noexcept {
+    if (const auto listener {new_action_listener_.exchange(nullptr)}) {
+        action_listener_ = std::move(*listener);
+    }
+
+    auto changed {false};
+    while (const auto action {actions_.TryPop()}) {
+        Execute(*action);
+        changed = true;
+    }
+
+    if (const auto descend_time {GetDescendTime()};
+        descend_time != scheduled_descend_time_) {
+        next_descent_ += descend_time - scheduled_descend_time_;
+        scheduled_descend_time_ = descend_time;
+    }
+
+    // Catch up on every descent that is due, so gravity never drifts.
+    while (running_ && now >= next_descent_) {
+        Descend();
+        next_descent_ += scheduled_descend_time_;
+        changed = true;
+    }
+
+    if (changed) {
+        Publish();
+    }
+
+    if (running_) {
+        return next_descent_;
+    } else {
+        return std::nullopt;
+    }
+}
+
+void Game::Wake() noexcept {
+    if (const auto slot {scheduler_slot_.load()}; slot != no_slot) {
+        scheduler_->Notify(slot);
+    } else {
+        notifier_.Notify();
+    }
+}
+
+void Game::SetDescendTime(
+    const std::chrono::steady_clock::duration time) noexcept {
+    descend_time_ = time;
+    if (!settings_.IsHeadless()) {
+        Wake();
+    }
+}
+
+std::chrono::steady_clock::duration Game::GetDescendTime() const noexcept {
+    return descend_time_;
 }
 
 ActionResult Game::Act(const Action action) noexcept {
-    if (IsOver()) {
+    assert(settings_.IsHeadless());
+    return Execute(action);
+}
+
+bool Game::Post(const Action action) noexcept {
+    assert(!settings_.IsHeadless());
+    if (!actions_.TryPush(action)) {
+        return false;
+    }
+
+    Wake();
+    return true;
+}
+
+void Game::SetActionListener(ActionListener listener) noexcept {
+    if (settings_.IsHeadless()) {
+        action_listener_ = std::move(listener);
+    } else {
+        // Only the game loop reads the listener, so it is always handed over.
+        new_action_listener_.store(
+            std::make_shared<ActionListener>(std::move(listener)));
+    }
+}
+
+ActionResult Game::Tick() noexcept {
+    assert(settings_.IsHeadless());
+    return Descend();
+}
+
+ActionResult Game::Execute(const Action action) noexcept {
+    if (running_ && action != Action::Non) {
+        ++action_count_;
+        if (action_listener_) {
+            action_listener_(tick_count_, action);
+        }
+    }
+
+    return Apply(action);
+}
+
+ActionResult Game::Descend() noexcept {
+    if (running_) {
+        ++tick_count_;
+    }
+
+    return Apply(Action::Descend);
+}
+
+std::shared_ptr<const GameState> Game::GetState() const noexcept {
+    return settings_.IsHeadless() ? TakeState() : state_.load();
+}
+
+std::shared_ptr<const GameState> Game::TakeState() const noexcept {
+    const auto next {PeekNextTetrominoes()};
+    return std::make_shared<const GameState>(GameState {
+        .grid = grid_->Fork(),
+        .next_tetrominoes = {next.begin(), next.end()},
+        .score = score_,
+        .line_count = line_count_,
+        .tick_count = tick_count_,
+        .piece_count = piece_count_,
+        .action_count = action_count_,
+        .over = !running_});
+}
+
+void Game::Publish() noexcept {
+    state_.store(TakeState());
+}
+
+ActionResult Game::Apply(const Action action) noexcept {
+    if (!running_) {
         return ActionResult::GameOver;
     }
 
-    const std::lock_guard lock {mtx_};
     auto succeeded {false};
     switch (action) {
         case Action::Non: {
@@ -88,19 +337,17 @@ ActionResult Game::Act(const Action action) noexcept {
         }
         case Action::Descend: {
             std::size_t cleared_line_count {0};
-            succeeded = grid_->TetrominoDescend(cleared_line_count);
-            score_ += cleared_line_count;
-            if (!succeeded) {
-                if (PushNextTetromino()) {
-                    return ActionResult::TetrominoFixed;
-                } else {
-                    running_ = false;
-                    return ActionResult::GameOver;
-                }
-            } else {
+            if (grid_->TetrominoDescend(cleared_line_count)) {
                 return ActionResult::Succeeded;
+            } else {
+                return OnTetrominoFixed(cleared_line_count);
             }
         }
+        case Action::HardDrop: {
+            std::size_t cleared_line_count {0};
+            grid_->TetrominoHardDrop(cleared_line_count);
+            return OnTetrominoFixed(cleared_line_count);
+        }
         default: {
             assert(false);
         }
@@ -109,32 +356,39 @@ ActionResult Game::Act(const Action action) noexcept {
     return succeeded ? ActionResult::Succeeded : ActionResult::Failed;
 }
 
-std::vector<std::reference_wrapper<const Tetromino>> Game::GetNextTetrominoes()
-    const noexcept {
-    const std::lock_guard lock {mtx_};
-    std::vector<std::reference_wrapper<const Tetromino>> tetrominoes;
-    std::ranges::for_each(next_tetrominoes_,
-                          [&tetrominoes](const auto& tetromino) noexcept {
-                              tetrominoes.push_back(*tetromino);
-                          });
-    return tetrominoes;
+ActionResult Game::OnTetrominoFixed(
+    const std::size_t cleared_line_count) noexcept {
+    score_ += cleared_line_count;
+    line_count_ += cleared_line_count;
+    if (PushNextTetromino()) {
+        return ActionResult::TetrominoFixed;
+    } else {
+        running_ = false;
+        return ActionResult::GameOver;
+    }
 }
 
-bool Game::PushNextTetromino() noexcept {
-    assert(!next_tetrominoes_.empty());
-    const auto pushed {
-        grid_->PushTetromino(std::move(next_tetrominoes_.front()))};
-    GenerateNextTetrominoes(1);
-    return pushed;
+std::vector<Piece> Game::GetNextTetrominoes() const noexcept {
+    if (settings_.IsHeadless()) {
+        const auto next {PeekNextTetrominoes()};
+        return {next.begin(), next.end()};
+    } else {
+        return GetState()->next_tetrominoes;
+    }
 }
 
-void Game::GenerateNextTetrominoes(const std::size_t count) noexcept {
-    for (std::size_t i {0}; i < count; ++i) {
-        const auto type {tetromino::GetRandomType()};
-        next_tetrominoes_.push_back(tetromino::Create(type));
+std::span<const Piece> Game::PeekNextTetrominoes() const noexcept {
+    return next_tetrominoes_.Peek(
+        std::min(settings_.GetNextCount(), next_tetrominoes_.GetSize()));
+}
 
-        if (next_tetrominoes_.size() > settings_.GetNextCount()) {
-            next_tetrominoes_.pop_front();
-        }
+bool Game::PushNextTetromino() noexcept {
+    // Keep the current tetromino and all the previews in the queue.
+    next_tetrominoes_.Fill(*generator_, settings_.GetNextCount() + 1);
+    const auto pushed {grid_->PushTetromino(next_tetrominoes_.Pop())};
+    if (pushed) {
+        ++piece_count_;
     }
+
+    return pushed;
 }
\ No newline at end of file
@@ -0,0 +1,114 @@
+#include "scheduler.h"
+#include "game.h"
+
+#include <bit>
+#include <cassert>
+
+
+GravityScheduler::GravityScheduler(
+    const std::size_t capacity,
+    const std::chrono::steady_clock::duration resolution) noexcept :
+    wheel_ {resolution},
+    games_(capacity, nullptr),
+    pending_word_count_ {(capacity + pending_word_bits - 1)
+                         / pending_word_bits} {
+    assert(capacity > 0);
+    free_slots_.reserve(capacity);
+    for (auto slot {capacity}; slot > 0; --slot) {
+        free_slots_.push_back(slot - 1);
+    }
+
+    pending_ =
+        std::make_unique<std::atomic<std::uint64_t>[]>(pending_word_count_);
+    thread_ = std::jthread {
+        [this](const std::stop_token token) { Loop(token); }};
+}
+
+GravityScheduler::~GravityScheduler() noexcept {
+    assert(GetGameCount() == 0);
+    thread_.request_stop();
+    thread_.join();
+}
+
+std::size_t GravityScheduler::GetCapacity() const noexcept {
+    return games_.size();
+}
+
+std::size_t GravityScheduler::GetGameCount() const noexcept {
+    const std::lock_guard lock {mtx_};
+    return games_.size() - free_slots_.size();
+}
+
+std::optional<std::size_t> GravityScheduler::Attach(Game& game) noexcept {
+    const std::lock_guard lock {mtx_};
+    if (free_slots_.empty()) {
+        return std::nullopt;
+    }
+
+    const auto slot {free_slots_.back()};
+    free_slots_.pop_back();
+    games_[slot] = &game;
+    wheel_.Schedule(slot, game.next_descent_);
+    // The thread may be waiting for a later deadline.
+    notifier_.Notify();
+    return slot;
+}
+
+void GravityScheduler::Detach(const std::size_t slot) noexcept {
+    const std::lock_guard lock {mtx_};
+    assert(games_[slot]);
+    games_[slot] = nullptr;
+    wheel_.Cancel(slot);
+    free_slots_.push_back(slot);
+}
+
+void GravityScheduler::Notify(const std::size_t slot) noexcept {
+    const auto bit {std::uint64_t {1} << (slot % pending_word_bits)};
+    // Wake up the thread only once until it handles the game.
+    if ((pending_[slot / pending_word_bits].fetch_or(bit) & bit) == 0) {
+        notifier_.Notify();
+    }
+}
+
+void GravityScheduler::Loop(const std::stop_token token) noexcept {
+    while (true) {
+        std::unique_lock lock {mtx_};
+        const auto wake_up_time {wheel_.GetNextWakeUpTime()};
+        lock.unlock();
+        // A stop request wakes up the thread immediately.
+        notifier_.WaitUntil(
+            wake_up_time.value_or(std::chrono::steady_clock::time_point::max()),
+            token);
+
+        if (token.stop_requested()) {
+            return;
+        }
+
+        lock.lock();
+        const auto now {std::chrono::steady_clock::now()};
+        for (std::size_t i {0}; i < pending_word_count_; ++i) {
+            auto bits {pending_[i].exchange(0)};
+            while (bits != 0) {
+                Process(i * pending_word_bits + std::countr_zero(bits), now);
+                bits &= bits - 1;
+            }
+        }
+
+        wheel_.Advance(now, [this, now](const std::size_t slot) {
+            Process(slot, now);
+        });
+    }
+}
+
+void GravityScheduler::Process(
+    const std::size_t slot,
+    const std::chrono::steady_clock::time_point now) noexcept {
+    // A game may have been detached after being marked.
+    if (auto* const game {games_[slot]}) {
+        if (const auto next_descent {game->Process(now)}) {
+            wheel_.Schedule(slot, *next_descent);
+        } else {
+            wheel_.Cancel(slot);
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,134 @@
+#include "generator.h"
+
+#include <algorithm>
+#include <unordered_map>
+
+
+namespace {
+
+Color GetRandomColor(Xoshiro256& eng) noexcept {
+    constexpr auto first {static_cast<std::uint64_t>(Color::Non) + 1};
+    constexpr auto last {static_cast<std::uint64_t>(Color::White)};
+    return static_cast<Color>(first + eng.Below(last - first + 1));
+}
+
+tetromino::Type GetRandomType(Xoshiro256& eng) noexcept {
+    return static_cast<tetromino::Type>(eng.Below(tetromino::type_count));
+}
+
+}  // namespace
+
+std::string to_string(const Randomizer randomizer) noexcept {
+    const static std::unordered_map<Randomizer, std::string_view> names {
+        {Randomizer::Uniform, "Uniform"},
+        {Randomizer::Bag7, "7-Bag"},
+        {Randomizer::Bag14, "14-Bag"},
+        {Randomizer::History, "History"},
+        {Randomizer::Custom, "Custom"}};
+
+    assert(names.contains(randomizer));
+    return names.at(randomizer).data();
+}
+
+std::ostream& operator<<(std::ostream& io,
+                         const Randomizer randomizer) noexcept {
+    return io << to_string(randomizer);
+}
+
+std::unique_ptr<PieceGenerator> CreateGenerator(
+    const Randomizer randomizer, const std::uint64_t seed) noexcept {
+    switch (randomizer) {
+        case Randomizer::Uniform: {
+            return std::make_unique<UniformGenerator>(seed);
+        }
+        case Randomizer::Bag7: {
+            return std::make_unique<BagGenerator>(seed, 1);
+        }
+        case Randomizer::Bag14: {
+            return std::make_unique<BagGenerator>(seed, 2);
+        }
+        case Randomizer::History: {
+            return std::make_unique<HistoryGenerator>(seed);
+        }
+        default: {
+            assert(false);
+            return nullptr;
+        }
+    }
+}
+
+UniformGenerator::UniformGenerator(const std::uint64_t seed) noexcept :
+    eng_ {seed} {}
+
+std::size_t UniformGenerator::Generate(const Batch batch) noexcept {
+    for (std::size_t i {0}; i < batch_size_; ++i) {
+        const auto type {GetRandomType(eng_)};
+        batch[i] = {type, Angle::Degree0, GetRandomColor(eng_)};
+    }
+
+    return batch_size_;
+}
+
+BagGenerator::BagGenerator(const std::uint64_t seed,
+                           const std::size_t copies) noexcept :
+    eng_ {seed}, bag_size_ {tetromino::type_count * copies} {
+    assert(copies > 0 && bag_size_ <= max_batch_size);
+}
+
+std::size_t BagGenerator::Generate(const Batch batch) noexcept {
+    for (std::size_t i {0}; i < bag_size_; ++i) {
+        const auto type {
+            static_cast<tetromino::Type>(i % tetromino::type_count)};
+        batch[i] = {type, Angle::Degree0, GetRandomColor(eng_)};
+    }
+
+    // Fisher-Yates shuffle.
+    for (auto i {bag_size_ - 1}; i > 0; --i) {
+        std::swap(batch[i], batch[eng_.Below(i + 1)]);
+    }
+
+    return bag_size_;
+}
+
+HistoryGenerator::HistoryGenerator(const std::uint64_t seed,
+                                   const std::size_t rerolls) noexcept :
+    eng_ {seed},
+    rerolls_ {rerolls},
+    history_ {tetromino::Type::Z, tetromino::Type::S, tetromino::Type::Z,
+              tetromino::Type::S} {}
+
+bool HistoryGenerator::InHistory(const tetromino::Type type) const noexcept {
+    return std::ranges::find(history_, type) != history_.cend();
+}
+
+std::size_t HistoryGenerator::Generate(const Batch batch) noexcept {
+    for (std::size_t i {0}; i < batch_size_; ++i) {
+        auto type {GetRandomType(eng_)};
+        for (std::size_t roll {0}; roll < rerolls_ && InHistory(type);
+             ++roll) {
+            type = GetRandomType(eng_);
+        }
+
+        history_[history_pos_] = type;
+        history_pos_ = (history_pos_ + 1) % history_size;
+        batch[i] = {type, Angle::Degree0, GetRandomColor(eng_)};
+    }
+
+    return batch_size_;
+}
+
+void PieceQueue::Fill(PieceGenerator& generator,
+                      const std::size_t count) noexcept {
+    assert(count + PieceGenerator::max_batch_size <= capacity);
+    std::array<Piece, PieceGenerator::max_batch_size> batch;
+    while (size_ < count) {
+        const auto generated {generator.Generate(batch)};
+        assert(0 < generated && generated <= batch.size());
+        for (std::size_t i {0}; i < generated; ++i) {
+            const auto tail {(head_ + size_) % capacity};
+            pieces_[tail] = batch[i];
+            pieces_[tail + capacity] = batch[i];
+            ++size_;
+        }
+    }
+}
\ No newline at end of file
@@ -1,127 +1,256 @@
 #include "grid.h"
+#include "row_scan.h"
 
+#include <algorithm>
+#include <array>
+#include <bit>
 #include <cassert>
+#include <cstring>
 
 
-void Cell::Clear() noexcept {
-    SetColor(Color::Non);
-}
+static_assert(sizeof(Color) == 1, "A cell of the color plane must be one byte");
 
-bool Cell::Filled() const noexcept {
-    return GetColor() != Color::Non;
-}
+Grid::Grid(const std::size_t width, const std::size_t height) noexcept :
+    width_ {width}, height_ {height} {
+    assert(width_ >= min_width_ && height_ >= min_height_);
+    assert(width_ <= std::numeric_limits<std::uint16_t>::max()
+           && height_ <= std::numeric_limits<std::uint16_t>::max());
+    entrance_ = {width_ / 2, 0};
+    row_words_ = (width_ + row_mask_bits - 1) / row_mask_bits;
+    const auto last_word_bits {width_ - (row_words_ - 1) * row_mask_bits};
+    last_word_mask_ = last_word_bits == row_mask_bits
+                          ? ~RowMask {0}
+                          : (RowMask {1} << last_word_bits) - 1;
+    board_ = std::make_shared<Board>(width_, height_, row_words_);
+}
+
+Grid::Grid(const Grid& other) noexcept :
+    Grid {other, std::make_shared<Board>(*other.board_)} {}
+
+Grid::Grid(const Grid& other, std::shared_ptr<Board> board) noexcept :
+    width_ {other.width_},
+    height_ {other.height_},
+    entrance_ {other.entrance_},
+    row_words_ {other.row_words_},
+    last_word_mask_ {other.last_word_mask_},
+    board_ {std::move(board)},
+    tetromino_ {other.tetromino_} {}
+
+Grid& Grid::operator=(const Grid& other) noexcept {
+    if (this != &other) {
+        *this = Grid {other};
+    }
 
-Color Cell::GetColor() const noexcept {
-    return color_;
+    return *this;
 }
 
-void Cell::SetColor(const Color color) noexcept {
-    color_ = color;
+Grid::Board::Board(const std::size_t width, const std::size_t height,
+                   const std::size_t row_words) noexcept :
+    rows(row_words * height),
+    row_counts(height),
+    column_tops(width, height),
+    colors(width * height, Color::Non) {}
+
+Grid::Board& Grid::GetMutableBoard() noexcept {
+    if (board_.use_count() > 1) {
+        board_ = std::make_shared<Board>(*board_);
+    }
+
+    return *board_;
 }
 
-Angle Grid::MovableTetromino::GetAngle() const noexcept {
-    return tetromino_->GetAngle();
+std::size_t Grid::GetHeight() const noexcept {
+    return height_;
 }
 
-void Grid::MovableTetromino::RotateLeft() noexcept {
-    tetromino_->RotateLeft();
+std::size_t Grid::GetWidth() const noexcept {
+    return width_;
 }
 
-void Grid::MovableTetromino::RotateRight() noexcept {
-    tetromino_->RotateRight();
+Color Grid::GetColor(const Point& pos) const noexcept {
+    if (FilledByTetromino(pos)) {
+        return tetromino_->GetColor();
+    } else if (pos.x < width_ && pos.y < height_) {
+        return GetColorRow(pos.y)[pos.x];
+    } else {
+        return Color::Non;
+    }
 }
 
-void Grid::MovableTetromino::RotateTo(const Angle angle) noexcept {
-    tetromino_->RotateTo(angle);
+bool Grid::Filled(const Point& pos) const noexcept {
+    if (FilledCell(pos)) {
+        return true;
+    } else {
+        return FilledByTetromino(pos);
+    }
 }
 
-void Grid::MovableTetromino::SetPosition(Point pos) noexcept {
-    pos_ = std::move(pos);
+bool Grid::FilledCell(const Point& pos) const noexcept {
+    if (pos.x < width_ && pos.y < height_) {
+        return TestCell(pos);
+    } else {
+        return true;
+    }
 }
 
-Point Grid::MovableTetromino::GetPosition() const noexcept {
-    return pos_;
+Grid::RowMask* Grid::GetRow(const std::size_t y) noexcept {
+    assert(y < height_);
+    return GetMutableBoard().rows.data() + y * row_words_;
 }
 
-Grid::MovableTetromino::MovableTetromino(std::unique_ptr<Tetromino> tetromino,
-                                         Point pos) noexcept :
-    tetromino_ {std::move(tetromino)}, pos_ {std::move(pos)} {}
+const Grid::RowMask* Grid::GetRow(const std::size_t y) const noexcept {
+    assert(y < height_);
+    return board_->rows.data() + y * row_words_;
+}
 
-std::size_t Grid::MovableTetromino::GetHeight() const noexcept {
-    return tetromino_->GetHeight();
+std::span<const Grid::RowMask> Grid::GetRowMask(
+    const std::size_t y) const noexcept {
+    return {GetRow(y), row_words_};
 }
 
-std::size_t Grid::MovableTetromino::GetWidth() const noexcept {
-    return tetromino_->GetWidth();
+std::size_t Grid::GetRowWordCount() const noexcept {
+    return row_words_;
 }
 
-bool Grid::MovableTetromino::Filled(const Point& pos) const noexcept {
-    return tetromino_->Filled(pos);
+std::uint64_t Grid::GetHash() const noexcept {
+    return board_->hash;
 }
 
-Color Grid::MovableTetromino::GetColor() const noexcept {
-    return tetromino_->GetColor();
+std::uint64_t Grid::GetCellKey(const Point& pos) noexcept {
+    // The finalizer of splitmix64 applied to the position.
+    auto z {((static_cast<std::uint64_t>(pos.y) << 32 | pos.x) + 1)
+            * 0x9E3779B97F4A7C15};
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EB;
+    return z ^ (z >> 31);
 }
 
-void Grid::MovableTetromino::SetColor(const Color color) noexcept {
-    return tetromino_->SetColor(color);
+std::uint64_t Grid::HashRows(const std::size_t y,
+                             const std::size_t row_count) const noexcept {
+    assert(y + row_count <= height_);
+    std::uint64_t hash {0};
+    for (auto row_y {y}; row_y < y + row_count; ++row_y) {
+        const auto row {GetRow(row_y)};
+        for (std::size_t i {0}; i < row_words_; ++i) {
+            for (auto bits {row[i]}; bits != 0; bits &= bits - 1) {
+                const auto x {i * row_mask_bits + std::countr_zero(bits)};
+                hash ^= GetCellKey({x, row_y});
+            }
+        }
+    }
+
+    return hash;
 }
 
-std::unique_ptr<Grid::MovableTetromino>
-Grid::MovableTetromino::GetTetrominoByAngle(const Angle angle) const noexcept {
-    return std::make_unique<MovableTetromino>(
-        tetromino_->GetTetrominoByAngle(angle), pos_);
+Color* Grid::GetColorRow(const std::size_t y) noexcept {
+    assert(y < height_);
+    return GetMutableBoard().colors.data() + y * width_;
 }
 
-Grid::Grid(const std::size_t width, const std::size_t height) noexcept :
-    width_ {width}, height_ {height} {
-    assert(width_ >= min_width_ && height_ >= min_height_);
-    entrance_ = {width_ / 2, 0};
-    cells_.resize(width_);
-    for (auto& col : cells_) {
-        col.resize(height_);
-    }
+const Color* Grid::GetColorRow(const std::size_t y) const noexcept {
+    assert(y < height_);
+    return board_->colors.data() + y * width_;
 }
 
-std::size_t Grid::GetHeight() const noexcept {
-    return height_;
+bool Grid::TestCell(const Point& pos) const noexcept {
+    assert(pos.x < width_ && pos.y < height_);
+    const auto word {GetRow(pos.y)[pos.x / row_mask_bits]};
+    return (word >> (pos.x % row_mask_bits)) & 1;
 }
 
-std::size_t Grid::GetWidth() const noexcept {
-    return width_;
+void Grid::SetCell(const Point& pos) noexcept {
+    assert(pos.x < width_ && pos.y < height_);
+    GetRow(pos.y)[pos.x / row_mask_bits] |= RowMask {1}
+                                             << (pos.x % row_mask_bits);
 }
 
-Color Grid::GetColor(const Point& pos) const noexcept {
-    if (FilledByTetromino(pos)) {
-        return tetromino_->GetColor();
-    } else if (pos.x < width_ && pos.y < height_) {
-        return cells_[pos.x][pos.y].GetColor();
+bool Grid::RowOverlaps(const std::size_t y, const std::size_t x,
+                       const RowMask mask) const noexcept {
+    if (mask == 0) {
+        return false;
+    } else if (y >= height_ || x >= width_
+               || static_cast<std::size_t>(std::bit_width(mask))
+                      > width_ - x) {
+        return true;
+    }
+
+    const auto row {GetRow(y)};
+    const auto word {x / row_mask_bits};
+    const auto shift {x % row_mask_bits};
+    if ((row[word] & (mask << shift)) != 0) {
+        return true;
+    } else if (shift != 0 && word + 1 < row_words_) {
+        return (row[word + 1] & (mask >> (row_mask_bits - shift))) != 0;
     } else {
-        return Color::Non;
+        return false;
     }
 }
 
-bool Grid::Filled(const Point& pos) const noexcept {
-    if (FilledCell(pos)) {
-        return true;
+void Grid::Reset() noexcept {
+    tetromino_.reset();
+    if (board_.use_count() > 1) {
+        // Do not clone a shared board only to clear it.
+        board_ = std::make_shared<Board>(width_, height_, row_words_);
     } else {
-        return FilledByTetromino(pos);
+        ClearRows(0, height_);
+        std::ranges::fill(board_->column_tops, height_);
+        board_->hash = 0;
     }
 }
 
-bool Grid::FilledCell(const Point& pos) const noexcept {
-    return Shape::Filled<decltype(cells_)>(cells_, pos, true);
+GridSnapshot Grid::Snapshot() const noexcept {
+    return {board_, tetromino_};
 }
 
-void Grid::Reset() noexcept {
-    tetromino_.reset();
-    ClearCells({0, 0}, width_, height_);
+void Grid::Restore(const GridSnapshot& snapshot) noexcept {
+    assert(snapshot.board_);
+    assert(snapshot.board_->row_counts.size() == height_
+           && snapshot.board_->column_tops.size() == width_);
+    // The board is cloned before it is changed, as it is shared with the snapshot.
+    board_ = std::const_pointer_cast<Board>(snapshot.board_);
+    tetromino_ = snapshot.tetromino_;
+}
+
+Grid Grid::Fork() const noexcept {
+    return {*this, board_};
+}
+
+std::vector<bool> Grid::GetDirtyRows(const Grid& since) const noexcept {
+    assert(since.width_ == width_ && since.height_ == height_);
+    std::vector<bool> dirty(height_, false);
+    if (board_ != since.board_) {
+        for (std::size_t y {0}; y < height_; ++y) {
+            dirty[y] = !std::ranges::equal(GetRowMask(y), since.GetRowMask(y))
+                       || std::memcmp(GetColorRow(y), since.GetColorRow(y),
+                                      width_ * sizeof(Color))
+                              != 0;
+        }
+    }
+
+    if (tetromino_ != since.tetromino_) {
+        for (const auto& piece : {tetromino_, since.tetromino_}) {
+            if (piece.has_value()) {
+                const auto top {piece->GetPosition().y};
+                const auto bottom {
+                    std::min(top + piece->GetHeight(), height_)};
+                std::fill(dirty.begin() + top, dirty.begin() + bottom, true);
+            }
+        }
+    }
+
+    return dirty;
 }
 
 bool Grid::PushTetromino(std::unique_ptr<Tetromino> tetromino,
                          const std::optional<Point> pos) noexcept {
+    assert(tetromino);
+    return PushTetromino(Piece::From(*tetromino), pos);
+}
+
+bool Grid::PushTetromino(const Piece piece,
+                         const std::optional<Point> pos) noexcept {
     assert(!tetromino_);
-    tetromino_ = std::make_unique<MovableTetromino>(std::move(tetromino));
+    tetromino_ = piece;
     if (MoveTetrominoTo(pos.value_or(entrance_))) {
         return true;
     } else {
@@ -130,21 +259,118 @@ bool Grid::PushTetromino(std::unique_ptr<Tetromino> tetromino,
     }
 }
 
-bool Grid::HasCollision(const Shape& shape, const Point& pos) const noexcept {
-    for (std::size_t i {0}; i < shape.GetWidth(); ++i) {
-        for (std::size_t j {0}; j < shape.GetHeight(); ++j) {
-            if (FilledCell({pos.x + i, pos.y + j}) && shape.Filled({i, j})) {
-                return true;
-            }
+const std::optional<Piece>& Grid::GetTetromino() const noexcept {
+    return tetromino_;
+}
+
+bool Grid::HasCollision(const tetromino::ShapeMask& mask,
+                        const Point& pos) const noexcept {
+    for (std::size_t j {0}; j < mask.height; ++j) {
+        if (RowOverlaps(pos.y + j, pos.x, mask.rows[j])) {
+            return true;
         }
     }
 
     return false;
 }
 
+bool Grid::CanPlace(const tetromino::Type type, const Angle angle,
+                    const Point& pos) const noexcept {
+    return !HasCollision(tetromino::GetShapeMask(type, angle), pos);
+}
+
+Point Grid::GetDropPosition(const tetromino::Type type, const Angle angle,
+                            const Point& pos) const noexcept {
+    assert(CanPlace(type, angle, pos));
+    const auto& mask {tetromino::GetShapeMask(type, angle)};
+    auto land_y {std::numeric_limits<std::size_t>::max()};
+    for (std::size_t i {0}; i < mask.width; ++i) {
+        const auto top {board_->column_tops[pos.x + i]};
+        const auto bottom {pos.y + mask.bottoms[i]};
+        if (bottom >= top) {
+            // The tetromino is under an overhang, so the column height is not an obstacle.
+            land_y = pos.y;
+            while (!HasCollision(mask, {pos.x, land_y + 1})) {
+                ++land_y;
+            }
+
+            return {pos.x, land_y};
+        }
+
+        land_y = std::min(land_y, top - 1 - mask.bottoms[i]);
+    }
+
+    return {pos.x, land_y};
+}
+
+Point Grid::GetDropPosition() const noexcept {
+    assert(tetromino_);
+    return GetDropPosition(tetromino_->GetType(), tetromino_->GetAngle(),
+                           tetromino_->GetPosition());
+}
+
+std::vector<Placement> Grid::GetPlacements(const tetromino::Type type,
+                                           const Angle angle,
+                                           const Point& pos) const noexcept {
+    const auto rotation_count {tetromino::GetRotationCount(type)};
+    std::array<const tetromino::ShapeMask*, angle_count> masks {};
+    for (std::size_t i {0}; i < rotation_count; ++i) {
+        masks[i] = &tetromino::GetShapeMask(type, static_cast<Angle>(i));
+    }
+
+    struct State {
+        std::size_t angle;
+        Point pos;
+    };
+
+    // Each state is tested for collisions once.
+    // A state is enqueued when it is first found to be free.
+    const auto state_count {rotation_count * height_ * width_};
+    std::vector<bool> tested(state_count), free(state_count);
+    std::vector<State> queue;
+    const auto probe {[&](const std::size_t rotation, const Point& at) noexcept {
+        if (at.x >= width_ || at.y >= height_) {
+            return false;
+        }
+
+        const auto i {(rotation * height_ + at.y) * width_ + at.x};
+        if (!tested[i]) {
+            tested[i] = true;
+            free[i] = !HasCollision(*masks[rotation], at);
+            if (free[i]) {
+                queue.push_back({rotation, at});
+            }
+        }
+
+        return static_cast<bool>(free[i]);
+    }};
+
+    std::vector<Placement> placements;
+    probe(static_cast<std::size_t>(angle) % rotation_count, pos);
+    for (std::size_t head {0}; head < queue.size(); ++head) {
+        const auto [rotation, at] {queue[head]};
+        // Moving to the left from the first column wraps to an invalid column.
+        probe(rotation, {at.x - 1, at.y});
+        probe(rotation, {at.x + 1, at.y});
+        probe((rotation + 1) % rotation_count, at);
+        probe((rotation + rotation_count - 1) % rotation_count, at);
+        if (!probe(rotation, {at.x, at.y + 1})) {
+            placements.push_back({static_cast<Angle>(rotation), at});
+        }
+    }
+
+    return placements;
+}
+
+std::vector<Placement> Grid::GetPlacements() const noexcept {
+    assert(tetromino_);
+    return GetPlacements(tetromino_->GetType(), tetromino_->GetAngle(),
+                         tetromino_->GetPosition());
+}
+
 bool Grid::CanMoveTetrominoTo(const Point& pos) const noexcept {
     assert(tetromino_);
-    return !HasCollision(*tetromino_, pos);
+    return !HasCollision(tetromino_->GetShapeMask(), pos);
 }
 
 bool Grid::MoveTetrominoTo(const Point& pos) noexcept {
@@ -157,86 +383,128 @@ bool Grid::MoveTetrominoTo(const Point& pos) noexcept {
     }
 }
 
-void Grid::ClearCells(const Point& pos, const std::size_t x_len,
-                      const std::size_t y_len) noexcept {
-    for (std::size_t i {0}; i < x_len; ++i) {
-        for (std::size_t j {0}; j < y_len; ++j) {
-            const auto x {pos.x + i};
-            const auto y {pos.y + j};
-            if (x < width_ && y < height_) {
-                cells_[x][y].Clear();
-            }
-        }
+void Grid::MoveRows(const std::size_t src, const std::size_t row_count,
+                    const std::size_t dst) noexcept {
+    assert(src + row_count <= height_ && dst + row_count <= height_);
+    if (row_count == 0) {
+        return;
     }
+
+    std::memmove(GetRow(dst), GetRow(src),
+                 row_count * row_words_ * sizeof(RowMask));
+    std::memmove(GetColorRow(dst), GetColorRow(src),
+                 row_count * width_ * sizeof(Color));
+    auto& row_counts {GetMutableBoard().row_counts};
+    std::memmove(row_counts.data() + dst, row_counts.data() + src,
+                 row_count * sizeof(std::size_t));
 }
 
-bool Grid::IsLineFull(const std::size_t y) const noexcept {
-    assert(y < height_);
-    for (std::size_t x {0}; x < width_; ++x) {
-        if (!Filled({x, y})) {
-            return false;
-        }
+void Grid::ClearRows(const std::size_t y, const std::size_t row_count) noexcept {
+    assert(y + row_count <= height_);
+    if (row_count == 0) {
+        return;
     }
 
-    return true;
+    std::memset(GetRow(y), 0, row_count * row_words_ * sizeof(RowMask));
+    std::memset(GetColorRow(y), static_cast<int>(Color::Non),
+                row_count * width_ * sizeof(Color));
+    std::fill_n(GetMutableBoard().row_counts.begin() + y, row_count, 0);
 }
 
-bool Grid::IsLineEmpty(const std::size_t y) const noexcept {
-    assert(y < height_);
-    for (std::size_t x {0}; x < width_; ++x) {
-        if (Filled({x, y})) {
-            return false;
-        }
-    }
+bool Grid::IsLineFull(const std::size_t y) const noexcept {
+    static_assert(std::is_same_v<RowMask, row_scan::Word>);
+    return row_scan::AllSet({GetRow(y), row_words_}, last_word_mask_);
+}
 
-    return true;
+bool Grid::IsLineEmpty(const std::size_t y) const noexcept {
+    return row_scan::AllClear({GetRow(y), row_words_});
 }
 
 void Grid::FixTetromino() noexcept {
     assert(tetromino_);
     const auto pos {tetromino_->GetPosition()};
     const auto color {tetromino_->GetColor()};
+    auto& board {GetMutableBoard()};
     assert(!CanMoveTetrominoTo({pos.x, pos.y + 1}));
-    for (std::size_t i {0}; i < tetromino_->GetWidth(); ++i) {
-        for (std::size_t j {0}; j < tetromino_->GetHeight(); ++j) {
-            if (tetromino_->Filled({i, j})) {
-                cells_[pos.x + i][pos.y + j].SetColor(color);
-            }
-        }
+    for (const auto& cell : tetromino_->GetShapeMask().cells) {
+        const Point fixed {pos.x + cell.x, pos.y + cell.y};
+        SetCell(fixed);
+        GetColorRow(fixed.y)[fixed.x] = color;
+        board.column_tops[fixed.x] =
+            std::min(board.column_tops[fixed.x], fixed.y);
+        ++board.row_counts[fixed.y];
+        board.hash ^= GetCellKey(fixed);
     }
 
     tetromino_.reset();
 }
 
-void Grid::ClearLine(std::size_t y) noexcept {
-    assert(!tetromino_);
-    assert(IsLineFull(y));
-    while (y > 0) {
-        --y;
-        for (std::size_t x {0}; x < width_; ++x) {
-            cells_[x][y + 1] = cells_[x][y];
-        }
-
-        if (IsLineEmpty(y)) {
-            break;
-        }
+std::size_t Grid::FindColumnTop(const std::size_t x,
+                                std::size_t y) const noexcept {
+    while (++y < height_ && !TestCell({x, y})) {
     }
+
+    return y;
+}
+
+std::size_t Grid::LockTetromino() noexcept {
+    assert(tetromino_);
+    const auto y {tetromino_->GetPosition().y};
+    const auto row_count {tetromino_->GetShapeMask().height};
+    FixTetromino();
+    return ClearLines(y, row_count);
 }
 
-std::size_t Grid::ClearLines() noexcept {
+std::size_t Grid::ClearLines(const std::size_t y,
+                             const std::size_t row_count) noexcept {
+    assert(!tetromino_);
+    assert(y + row_count <= height_);
+    // The full lines from bottom to top.
+    std::array<std::size_t, tetromino::max_size> full_lines;
+    assert(row_count <= full_lines.size());
     std::size_t count {0};
-    std::size_t y {height_};
-    while (y > 0) {
-        --y;
-        if (IsLineEmpty(y)) {
-            break;
-        } else if (IsLineFull(y)) {
-            ClearLine(y);
-            ++y;
-            ++count;
+    for (auto line {y + row_count}; line > y;) {
+        if (board_->row_counts[--line] == width_) {
+            assert(IsLineFull(line));
+            full_lines[count++] = line;
         }
     }
 
+    if (count == 0) {
+        return 0;
+    }
+
+    // Rows above the first empty row are empty, so they need not be moved.
+    auto top {full_lines[count - 1]};
+    while (top > 0 && board_->row_counts[top - 1] != 0) {
+        --top;
+    }
+
+    assert(top == 0 || IsLineEmpty(top - 1));
+
+    // Only the cells between the top and the lowest full line change, so their keys are replaced.
+    const auto changed_row_count {full_lines[0] + 1 - top};
+    const auto old_hash {HashRows(top, changed_row_count)};
+
+    // Each block of rows between two full lines descends by the number of full lines below it.
+    // Moving the lowest block first never overwrites a block that has not been moved.
+    for (std::size_t i {0}; i < count; ++i) {
+        const auto end {full_lines[i]};
+        const auto begin {i + 1 < count ? full_lines[i + 1] + 1 : top};
+        MoveRows(begin, end - begin, begin + i + 1);
+    }
+
+    ClearRows(top, count);
+    auto& board {GetMutableBoard()};
+    board.hash ^= old_hash ^ HashRows(top, changed_row_count);
+
+    // Every column is filled in a full line, so no column top is below the lowest cleared line.
+    // Each column top descends to the next filled cell below its old top shifted by the cleared lines.
+    for (std::size_t x {0}; x < width_; ++x) {
+        board.column_tops[x] =
+            FindColumnTop(x, board.column_tops[x] + count - 1);
+    }
+
     return count;
 }
 
@@ -252,35 +520,31 @@ bool Grid::MoveTetrominoToRight() noexcept {
     return MoveTetrominoTo({pos.x + 1, pos.y});
 }
 
-bool Grid::RotateTetrominoLeft() noexcept {
+bool Grid::RotateTetrominoTo(const Angle angle) noexcept {
     assert(tetromino_);
-    const auto angle {RotateAngleLeft(tetromino_->GetAngle())};
-    const auto rotated {tetromino_->GetTetrominoByAngle(angle)};
-    if (!HasCollision(*rotated, rotated->GetPosition())) {
-        tetromino_->RotateLeft();
+    if (CanPlace(tetromino_->GetType(), angle, tetromino_->GetPosition())) {
+        tetromino_->RotateTo(angle);
         return true;
     } else {
         return false;
     }
 }
 
+bool Grid::RotateTetrominoLeft() noexcept {
+    assert(tetromino_);
+    return RotateTetrominoTo(RotateAngleLeft(tetromino_->GetAngle()));
+}
+
 bool Grid::RotateTetrominoRight() noexcept {
     assert(tetromino_);
-    const auto angle {RotateAngleRight(tetromino_->GetAngle())};
-    const auto rotated {tetromino_->GetTetrominoByAngle(angle)};
-    if (!HasCollision(*rotated, rotated->GetPosition())) {
-        tetromino_->RotateRight();
-        return true;
-    } else {
-        return false;
-    }
+    return RotateTetrominoTo(RotateAngleRight(tetromino_->GetAngle()));
 }
 
 bool Grid::FilledByTetromino(const Point& pos) const noexcept {
     if (tetromino_) {
         if (const auto tetromino_pos {tetromino_->GetPosition()};
             pos.x >= tetromino_pos.x && pos.y >= tetromino_pos.y) {
-            return tetromino_->Filled(
+            return tetromino_->GetShapeMask().Filled(
                 {pos.x - tetromino_pos.x, pos.y - tetromino_pos.y});
         }
     }
@@ -288,14 +552,19 @@ bool Grid::FilledByTetromino(const Point& pos) const noexcept {
     return false;
 }
 
+void Grid::TetrominoHardDrop(std::size_t& cleared_line_count) noexcept {
+    assert(tetromino_);
+    tetromino_->SetPosition(GetDropPosition());
+    cleared_line_count = LockTetromino();
+}
+
 bool Grid::TetrominoDescend(std::size_t& cleared_line_count) noexcept {
     assert(tetromino_);
     cleared_line_count = 0;
     const auto pos {tetromino_->GetPosition()};
     const auto moved {MoveTetrominoTo({pos.x, pos.y + 1})};
     if (!moved) {
-        FixTetromino();
-        cleared_line_count = ClearLines();
+        cleared_line_count = LockTetromino();
     }
 
     return moved;
@@ -0,0 +1,105 @@
+#include "latency.h"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cmath>
+
+
+namespace {
+
+constexpr std::size_t value_bits {64};
+
+}  // namespace
+
+
+LatencyHistogram::LatencyHistogram() noexcept :
+    counts_(sub_bucket_count
+                + (value_bits - sub_bucket_bits) * half_sub_bucket_count,
+            0) {}
+
+std::size_t LatencyHistogram::GetBucket(const std::uint64_t value) noexcept {
+    if (value < sub_bucket_count) {
+        return value;
+    }
+
+    // Keep the highest bits of the value, so the bucket width grows with it.
+    const auto shift {std::bit_width(value) - sub_bucket_bits};
+    const auto top {value >> shift};
+    return sub_bucket_count + (shift - 1) * half_sub_bucket_count
+           + (top - half_sub_bucket_count);
+}
+
+std::uint64_t LatencyHistogram::GetHighestValue(
+    const std::size_t bucket) noexcept {
+    if (bucket < sub_bucket_count) {
+        return bucket;
+    }
+
+    const auto shift {(bucket - sub_bucket_count) / half_sub_bucket_count + 1};
+    const auto top {half_sub_bucket_count
+                    + (bucket - sub_bucket_count) % half_sub_bucket_count};
+    return ((std::uint64_t {top} + 1) << shift) - 1;
+}
+
+void LatencyHistogram::Record(const Duration duration) noexcept {
+    const auto value {static_cast<std::uint64_t>(
+        std::max<Duration::rep>(duration.count(), 0))};
+    ++counts_[GetBucket(value)];
+    ++count_;
+    min_ = std::min(min_, value);
+    max_ = std::max(max_, value);
+}
+
+std::size_t LatencyHistogram::GetCount() const noexcept {
+    return count_;
+}
+
+LatencyHistogram::Duration LatencyHistogram::GetMin() const noexcept {
+    return Duration {count_ > 0 ? static_cast<Duration::rep>(min_) : 0};
+}
+
+LatencyHistogram::Duration LatencyHistogram::GetMax() const noexcept {
+    return Duration {static_cast<Duration::rep>(max_)};
+}
+
+LatencyHistogram::Duration LatencyHistogram::GetPercentile(
+    const double percentile) const noexcept {
+    assert(0 <= percentile && percentile <= 100);
+    if (count_ == 0) {
+        return Duration::zero();
+    }
+
+    const auto rank {std::clamp<std::size_t>(
+        static_cast<std::size_t>(std::ceil(percentile / 100 * count_)), 1,
+        count_)};
+    std::size_t seen {0};
+    for (std::size_t bucket {0}; bucket < counts_.size(); ++bucket) {
+        seen += counts_[bucket];
+        if (seen >= rank) {
+            // A bucket may extend beyond the largest record.
+            return Duration {static_cast<Duration::rep>(
+                std::min(GetHighestValue(bucket), max_))};
+        }
+    }
+
+    assert(false);
+    return GetMax();
+}
+
+void LatencyHistogram::Merge(const LatencyHistogram& other) noexcept {
+    for (std::size_t bucket {0}; bucket < counts_.size(); ++bucket) {
+        counts_[bucket] += other.counts_[bucket];
+    }
+
+    count_ += other.count_;
+    min_ = std::min(min_, other.min_);
+    max_ = std::max(max_, other.max_);
+}
+
+void LatencyHistogram::Clear() noexcept {
+    std::fill(counts_.begin(), counts_.end(), 0);
+    count_ = 0;
+    min_ = UINT64_MAX;
+    max_ = 0;
+}
\ No newline at end of file
@@ -13,14 +13,82 @@
 #include "args.h"
 #include "controller.h"
 #include "game.h"
+#include "policy.h"
+#include "replay.h"
+#include "runner.h"
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+
+
+namespace {
+
+//! Set by @p SIGUSR1 to write the latency report while the game is running.
+std::atomic<bool> latency_requested {false};
+
+void RequestLatency(int) noexcept {
+    latency_requested = true;
+}
+
+//! Overwrite the latency report with the percentiles so far.
+void WriteLatency(const Controller& controller, const std::string& path) {
+    std::ofstream file {path};
+    if (!file) {
+        throw std::runtime_error {"Failed to create the latency report."};
+    }
+
+    controller.PrintLatency(file);
+}
+
+/**
+ * @brief Play a headless game with the autoplayer as fast as possible and print the result.
+ *
+ * @param game A started headless game.
+ * @param player The autoplayer.
+ * @param stats The search statistics of the autoplayer, or @p nullptr if it does not search.
+ * @param max_piece_count The number of tetrominoes to place. @p 0 means playing until the game is over.
+ */
+void PrintAutoplay(Game& game, Policy& player, const SearchStats* const stats,
+                   const std::size_t max_piece_count) noexcept {
+    constexpr std::size_t max_actions_per_tick {8};
+    const auto begin {std::chrono::steady_clock::now()};
+    PlayGame(game, player, max_actions_per_tick,
+             max_piece_count > 0 ? max_piece_count
+                                 : std::numeric_limits<std::size_t>::max());
+    const std::chrono::duration<double> elapsed {std::chrono::steady_clock::now()
+                                                 - begin};
+    std::cout << "Seed: " << game.GetSeed() << '\n'
+              << "Pieces: " << game.GetPieceCount() << '\n'
+              << "Lines: " << game.GetLineCount() << '\n'
+              << "Score: " << game.GetScore() << '\n'
+              << "Seconds: " << elapsed.count() << '\n'
+              << "Pieces/sec: "
+              << (elapsed.count() > 0 ? game.GetPieceCount() / elapsed.count()
+                                      : 0)
+              << '\n';
+    if (stats) {
+        std::cout << "Nodes: " << stats->node_count << '\n'
+                  << "Nodes/sec: " << stats->GetNodesPerSecond() << '\n'
+                  << "Cache hits: " << stats->cache_hit_count << '\n'
+                  << "Timeouts: " << stats->timeout_count << '\n';
+    }
+
+    std::cout << std::flush;
+}
+
+}  // namespace
 
 
 int main(int, char* argv[]) {
     try {
-        const Controller::Initializer gui_initer;
-
         CmdArgs args;
         args.Parse(argv);
 
@@ -28,16 +96,78 @@ int main(int, char* argv[]) {
         const auto width {std::max(args.GetWidth(), min_width)};
         const auto height {std::max(args.GetHeight(), min_height)};
 
+        // The autoplayer runs a headless game from the main thread, so it never races with a game loop thread.
+        const auto autoplay {args.IsAutoplay() || args.IsHeadless()};
         GameSettings settings;
         settings.SetDescendTime(std::chrono::seconds {1});
+        if (const auto count {args.GetNextCount()}; count > 0) {
+            settings.SetNextCount(count);
+        }
+
+        std::unique_ptr<Policy> player;
+        const SearchStats* stats {nullptr};
+        if (autoplay) {
+            settings.SetHeadless(true).SetSeed(args.GetSeed());
+            if (const auto width {args.GetBeamWidth()}; width > 0) {
+                auto beam {std::make_unique<BeamSearchPolicy>(
+                    std::make_shared<WorkStealingPool>(args.GetThreadCount()))};
+                beam->SetBeamWidth(width);
+                if (const auto budget {args.GetBudget()}; budget > 0) {
+                    beam->SetDeadline(std::chrono::milliseconds {budget});
+                }
+
+                stats = &beam->GetStats();
+                player = std::move(beam);
+            } else {
+                player = std::make_unique<HeuristicPolicy>();
+            }
+        }
+
         auto game {std::make_unique<Game>(std::make_unique<Grid>(width, height),
                                           std::move(settings))};
         game->Start();
-        Controller controller {std::move(game)};
-        while (!controller.IsOver()) {
-            controller.Input();
-            controller.Update();
-            controller.Refresh();
+
+        std::ofstream replay_file;
+        std::optional<ReplayRecorder> recorder;
+        if (const auto path {args.GetRecordPath()}; !path.empty()) {
+            replay_file.open(path, std::ios::binary);
+            if (!replay_file) {
+                throw std::runtime_error {"Failed to create the replay."};
+            }
+
+            recorder.emplace(replay_file).Attach(*game);
+        }
+
+        if (args.IsHeadless()) {
+            PrintAutoplay(*game, *player, stats, args.GetPieceCount());
+            if (recorder.has_value()) {
+                recorder->Finish();
+            }
+        } else {
+            const Controller::Initializer gui_initer;
+            Controller controller {std::move(game), std::move(player)};
+            const auto latency_path {args.GetLatencyPath()};
+            if (!latency_path.empty()) {
+                std::signal(SIGUSR1, RequestLatency);
+            }
+
+            while (!controller.IsOver()) {
+                controller.Input();
+                controller.Update();
+                controller.Refresh();
+                if (!latency_path.empty()
+                    && latency_requested.exchange(false)) {
+                    WriteLatency(controller, latency_path);
+                }
+            }
+
+            if (!latency_path.empty()) {
+                WriteLatency(controller, latency_path);
+            }
+
+            if (recorder.has_value()) {
+                recorder->Finish();
+            }
         }
 
         return EXIT_SUCCESS;
@@ -0,0 +1,28 @@
+#include "piece.h"
+
+#include <cassert>
+
+
+Piece Piece::Create(const tetromino::Type type, const Angle angle,
+                    const std::optional<Color> color) noexcept {
+    if (color.value_or(Color::Non) == Color::Non) {
+        return {type, angle, GetRandomColor()};
+    } else {
+        return {type, angle, color.value()};
+    }
+}
+
+Piece Piece::From(const Tetromino& tetromino) noexcept {
+    assert(tetromino.GetColor() != Color::Non);
+    return {tetromino.GetType(), tetromino.GetAngle(), tetromino.GetColor()};
+}
+
+std::unique_ptr<Tetromino> Piece::ToTetromino() const noexcept {
+    return tetromino::Create(type_, angle_, color_);
+}
+
+std::ostream& operator<<(std::ostream& os, const Piece& piece) noexcept {
+    const auto pos {piece.GetPosition()};
+    return os << piece.GetType() << ' ' << piece.GetAngle() << ' '
+              << piece.GetColor() << " (" << pos.x << ", " << pos.y << ')';
+}
\ No newline at end of file
@@ -0,0 +1,351 @@
+#include "policy.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <iterator>
+#include <limits>
+#include <unordered_set>
+
+
+namespace {
+
+//! Get the number of left rotations turning an angle into another, where @p 3 means a right rotation.
+std::size_t GetRotationSteps(const Angle from, const Angle to) noexcept {
+    return (static_cast<std::size_t>(to) + angle_count
+            - static_cast<std::size_t>(from))
+           % angle_count;
+}
+
+/**
+ * @brief Call a function with each placement the current tetromino reaches
+ * by rotating in place, moving horizontally and dropping straight down.
+ *
+ * @details
+ * Rotations of the same layout are visited once.
+ */
+template <typename Func>
+void ForEachDrop(const Grid& grid, Func&& func) noexcept {
+    const auto& piece {*grid.GetTetromino()};
+    const auto type {piece.GetType()};
+    const auto pos {piece.GetPosition()};
+    const auto rotation_count {tetromino::GetRotationCount(type)};
+    auto left_angle {piece.GetAngle()};
+    auto left_reachable {true};
+    for (std::size_t steps {0}; steps < rotation_count; ++steps) {
+        Angle angle {};
+        auto reachable {false};
+        if (steps == 3) {
+            angle = RotateAngleRight(piece.GetAngle());
+            reachable = grid.CanPlace(type, angle, pos);
+        } else {
+            if (steps > 0) {
+                left_angle = RotateAngleLeft(left_angle);
+                left_reachable =
+                    left_reachable && grid.CanPlace(type, left_angle, pos);
+            }
+
+            angle = left_angle;
+            reachable = left_reachable;
+        }
+
+        if (!reachable) {
+            continue;
+        }
+
+        auto min_x {pos.x};
+        while (min_x > 0 && grid.CanPlace(type, angle, {min_x - 1, pos.y})) {
+            --min_x;
+        }
+
+        auto max_x {pos.x};
+        while (grid.CanPlace(type, angle, {max_x + 1, pos.y})) {
+            ++max_x;
+        }
+
+        for (auto x {min_x}; x <= max_x; ++x) {
+            func(Placement {angle,
+                            grid.GetDropPosition(type, angle, {x, pos.y})});
+        }
+    }
+}
+
+//! Execute a placement of the current tetromino on a grid.
+std::size_t Place(Grid& grid, const Placement& placement) noexcept {
+    const auto steps {
+        GetRotationSteps(grid.GetTetromino()->GetAngle(), placement.angle)};
+    if (steps == 3) {
+        [[maybe_unused]] const auto rotated {grid.RotateTetrominoRight()};
+        assert(rotated);
+    } else {
+        for (std::size_t i {0}; i < steps; ++i) {
+            [[maybe_unused]] const auto rotated {grid.RotateTetrominoLeft()};
+            assert(rotated);
+        }
+    }
+
+    while (grid.GetTetromino()->GetPosition().x > placement.pos.x) {
+        [[maybe_unused]] const auto moved {grid.MoveTetrominoToLeft()};
+        assert(moved);
+    }
+
+    while (grid.GetTetromino()->GetPosition().x < placement.pos.x) {
+        [[maybe_unused]] const auto moved {grid.MoveTetrominoToRight()};
+        assert(moved);
+    }
+
+    std::size_t cleared_line_count {0};
+    grid.TetrominoHardDrop(cleared_line_count);
+    return cleared_line_count;
+}
+
+}  // namespace
+
+RandomPolicy::RandomPolicy(const std::uint64_t seed) noexcept : eng_ {seed} {}
+
+Action RandomPolicy::Decide(const Game&) noexcept {
+    static constexpr std::array actions {
+        Action::Non,        Action::MoveToLeft,  Action::MoveToRight,
+        Action::RotateLeft, Action::RotateRight, Action::Descend};
+    std::uniform_int_distribution<std::size_t> dist(0, actions.size() - 1);
+    return actions[dist(eng_)];
+}
+
+Action PlacementPolicy::Decide(const Game& game) noexcept {
+    const auto grid {game.GetGrid()};
+    const auto& current {grid->GetTetromino()};
+    if (!current.has_value()) {
+        return Action::Non;
+    }
+
+    if (const auto piece_count {game.GetPieceCount()};
+        piece_count != planned_piece_count_) {
+        planned_piece_count_ = piece_count;
+        target_ = Plan(*grid, game.GetNextTetrominoes());
+    }
+
+    if (!target_.has_value()) {
+        return Action::HardDrop;
+    }
+
+    switch (GetRotationSteps(current->GetAngle(), target_->angle)) {
+        case 0: {
+            break;
+        }
+        case 3: {
+            return Action::RotateRight;
+        }
+        default: {
+            return Action::RotateLeft;
+        }
+    }
+
+    if (const auto x {current->GetPosition().x}; x > target_->pos.x) {
+        return Action::MoveToLeft;
+    } else if (x < target_->pos.x) {
+        return Action::MoveToRight;
+    } else {
+        return Action::HardDrop;
+    }
+}
+
+HeuristicPolicy::HeuristicPolicy(const FeatureWeights weights) noexcept :
+    weights_ {weights} {}
+
+std::optional<Placement> HeuristicPolicy::Plan(
+    const Grid& grid, const std::span<const Piece> next) noexcept {
+    std::optional<Placement> best;
+    auto best_score {std::numeric_limits<double>::lowest()};
+    ForEachDrop(grid, [&](const Placement& placement) {
+        double score {0};
+        if (next.empty()) {
+            const Piece placed {grid.GetTetromino()->GetType(),
+                                placement.angle, Color::Non, placement.pos};
+            score = Evaluate(extractor_.Extract(grid, placed), weights_);
+        } else {
+            auto fork {grid.Fork()};
+            const auto cleared_line_count {Place(fork, placement)};
+            score = fork.PushTetromino(next.front())
+                        ? EvaluateBest(fork, cleared_line_count)
+                              .value_or(std::numeric_limits<double>::lowest())
+                        : std::numeric_limits<double>::lowest();
+        }
+
+        if (!best.has_value() || score > best_score) {
+            best = placement;
+            best_score = score;
+        }
+    });
+
+    return best;
+}
+
+std::optional<double> HeuristicPolicy::EvaluateBest(
+    const Grid& grid, const std::size_t cleared_line_count) noexcept {
+    const auto type {grid.GetTetromino()->GetType()};
+    std::optional<double> best;
+    ForEachDrop(grid, [&](const Placement& placement) {
+        auto features {extractor_.Extract(
+            grid, Piece {type, placement.angle, Color::Non, placement.pos})};
+        features.completed_lines += cleared_line_count;
+        const auto score {Evaluate(features, weights_)};
+        if (!best.has_value() || score > *best) {
+            best = score;
+        }
+    });
+
+    return best;
+}
+
+double SearchStats::GetNodesPerSecond() const noexcept {
+    const std::chrono::duration<double> seconds {elapsed};
+    return seconds.count() > 0 ? node_count / seconds.count() : 0;
+}
+
+BeamSearchPolicy::BeamSearchPolicy(std::shared_ptr<WorkStealingPool> pool,
+                                   const FeatureWeights weights) noexcept :
+    pool_ {std::move(pool)},
+    weights_ {weights},
+    extractors_(pool_ ? pool_->GetThreadCount() : 1) {}
+
+BeamSearchPolicy& BeamSearchPolicy::SetBeamWidth(
+    const std::size_t width) noexcept {
+    beam_width_ = std::max<std::size_t>(width, 1);
+    return *this;
+}
+
+BeamSearchPolicy& BeamSearchPolicy::SetMaxDepth(
+    const std::size_t depth) noexcept {
+    max_depth_ = depth;
+    return *this;
+}
+
+BeamSearchPolicy& BeamSearchPolicy::SetDeadline(
+    const std::optional<std::chrono::steady_clock::duration> time) noexcept {
+    deadline_ = time;
+    return *this;
+}
+
+BeamSearchPolicy& BeamSearchPolicy::SetTranspositionTable(
+    std::shared_ptr<TranspositionTable> table) noexcept {
+    table_ = std::move(table);
+    return *this;
+}
+
+const SearchStats& BeamSearchPolicy::GetStats() const noexcept {
+    return stats_;
+}
+
+std::size_t BeamSearchPolicy::Expand(const Node& node, const bool root,
+                                     std::vector<Node>& children,
+                                     FeatureExtractor& extractor) noexcept {
+    std::size_t hit_count {0};
+    ForEachDrop(node.grid, [&](const Placement& placement) {
+        auto grid {node.grid.Fork()};
+        const auto line_count {node.line_count + Place(grid, placement)};
+
+        // The board is evaluated without cleared lines, which depend on the path.
+        std::optional<double> value;
+        if (table_) {
+            value = table_->Find(grid.GetHash());
+        }
+
+        if (value.has_value()) {
+            ++hit_count;
+        } else {
+            auto features {extractor.Extract(grid)};
+            features.completed_lines = 0;
+            value = Evaluate(features, weights_);
+            if (table_) {
+                table_->Insert(grid.GetHash(), *value);
+            }
+        }
+
+        const auto score {*value + weights_.completed_lines * line_count};
+        children.push_back({std::move(grid), root ? placement : node.first,
+                            score, line_count});
+    });
+
+    return hit_count;
+}
+
+std::optional<Placement> BeamSearchPolicy::Plan(
+    const Grid& grid, const std::span<const Piece> next) noexcept {
+    const auto begin {std::chrono::steady_clock::now()};
+    const auto deadline {deadline_.has_value()
+                             ? begin + *deadline_
+                             : std::chrono::steady_clock::time_point::max()};
+    const auto depth {std::min(next.size(), max_depth_) + 1};
+
+    std::vector<Node> beam;
+    beam.push_back({grid.Fork(), {}, 0, 0});
+    std::optional<Placement> best;
+    std::atomic_bool timeout {false};
+    for (std::size_t level {0}; level < depth; ++level) {
+        if (level > 0) {
+            std::erase_if(beam, [&](Node& node) {
+                return !node.grid.PushTetromino(next[level - 1]);
+            });
+        }
+
+        children_.resize(beam.size());
+        std::vector<std::size_t> hit_counts(beam.size());
+        const auto expand {[&](const std::size_t i, const std::size_t worker) {
+            children_[i].clear();
+            // The current tetromino is always searched to have a placement.
+            if (level > 0 && timeout.load(std::memory_order_relaxed)) {
+                return;
+            }
+
+            hit_counts[i] =
+                Expand(beam[i], level == 0, children_[i], extractors_[worker]);
+            if (std::chrono::steady_clock::now() >= deadline) {
+                timeout.store(true, std::memory_order_relaxed);
+            }
+        }};
+
+        if (pool_) {
+            pool_->ParallelFor(beam.size(), expand);
+        } else {
+            for (std::size_t i {0}; i < beam.size(); ++i) {
+                expand(i, 0);
+            }
+        }
+
+        // Children are merged in the order of their parents, so the result does not depend on scheduling.
+        std::vector<Node> candidates;
+        for (std::size_t i {0}; i < beam.size(); ++i) {
+            stats_.node_count += children_[i].size();
+            stats_.cache_hit_count += hit_counts[i];
+            std::ranges::move(children_[i], std::back_inserter(candidates));
+        }
+
+        if ((level > 0 && timeout) || candidates.empty()) {
+            break;
+        }
+
+        // Keep the best node of each distinct board.
+        std::ranges::stable_sort(candidates, std::ranges::greater {},
+                                 &Node::score);
+        std::unordered_set<std::uint64_t> boards;
+        beam.clear();
+        for (auto& node : candidates) {
+            if (beam.size() == beam_width_) {
+                break;
+            } else if (boards.insert(node.grid.GetHash()).second) {
+                beam.push_back(std::move(node));
+            }
+        }
+
+        best = beam.front().first;
+        if (timeout) {
+            break;
+        }
+    }
+
+    ++stats_.search_count;
+    stats_.timeout_count += timeout ? 1 : 0;
+    stats_.elapsed += std::chrono::steady_clock::now() - begin;
+    return best;
+}
\ No newline at end of file
@@ -0,0 +1,184 @@
+#include "pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <optional>
+#include <thread>
+#include <vector>
+
+
+class WorkStealingPool::Impl {
+public:
+    explicit Impl(const std::size_t thread_count) noexcept :
+        ranges_(thread_count) {
+        assert(thread_count > 0);
+        for (std::size_t i {1}; i < thread_count; ++i) {
+            threads_.emplace_back([this, i]() noexcept { Loop(i); });
+        }
+    }
+
+    std::size_t GetThreadCount() const noexcept {
+        return ranges_.size();
+    }
+
+    void ParallelFor(const std::size_t count, const Task& task) noexcept {
+        assert(count <= std::numeric_limits<std::uint32_t>::max());
+        if (count == 0) {
+            return;
+        }
+
+        // Split the tasks evenly. Workers steal from each other when they finish early.
+        const auto worker_count {GetThreadCount()};
+        for (std::size_t i {0}; i < worker_count; ++i) {
+            ranges_[i].bounds.store(Pack(count * i / worker_count,
+                                         count * (i + 1) / worker_count),
+                                    std::memory_order_relaxed);
+        }
+
+        task_ = &task;
+        busy_.store(worker_count - 1, std::memory_order_relaxed);
+        generation_.fetch_add(1, std::memory_order_release);
+        generation_.notify_all();
+
+        Work(0);
+        for (auto busy {busy_.load(std::memory_order_acquire)}; busy != 0;
+             busy = busy_.load(std::memory_order_acquire)) {
+            busy_.wait(busy, std::memory_order_acquire);
+        }
+
+        task_ = nullptr;
+    }
+
+    ~Impl() noexcept {
+        stopping_.store(true, std::memory_order_relaxed);
+        generation_.fetch_add(1, std::memory_order_release);
+        generation_.notify_all();
+        for (auto& thread : threads_) {
+            thread.join();
+        }
+    }
+
+private:
+    //! A range of task indices packed as <tt>end << 32 | begin</tt>.
+    struct alignas(std::hardware_destructive_interference_size) Range {
+        std::atomic<std::uint64_t> bounds {0};
+    };
+
+    static constexpr std::uint64_t Pack(const std::size_t begin,
+                                        const std::size_t end) noexcept {
+        return static_cast<std::uint64_t>(end) << 32 | begin;
+    }
+
+    static constexpr std::size_t GetBegin(const std::uint64_t range) noexcept {
+        return range & std::numeric_limits<std::uint32_t>::max();
+    }
+
+    static constexpr std::size_t GetEnd(const std::uint64_t range) noexcept {
+        return range >> 32;
+    }
+
+    //! Wait for jobs until the pool is destroyed.
+    void Loop(const std::size_t worker) noexcept {
+        std::uint64_t generation {0};
+        while (true) {
+            generation_.wait(generation, std::memory_order_acquire);
+            generation = generation_.load(std::memory_order_acquire);
+            if (stopping_.load(std::memory_order_relaxed)) {
+                return;
+            }
+
+            Work(worker);
+            if (busy_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                busy_.notify_one();
+            }
+        }
+    }
+
+    //! Run tasks from the worker's own range and steal more until none is left.
+    void Work(const std::size_t worker) noexcept {
+        while (true) {
+            if (const auto index {Pop(worker)}; index.has_value()) {
+                (*task_)(index.value(), worker);
+            } else if (!Steal(worker)) {
+                return;
+            }
+        }
+    }
+
+    //! Take a task from the front of the worker's own range.
+    std::optional<std::size_t> Pop(const std::size_t worker) noexcept {
+        auto& bounds {ranges_[worker].bounds};
+        auto range {bounds.load(std::memory_order_acquire)};
+        while (GetBegin(range) < GetEnd(range)) {
+            if (bounds.compare_exchange_weak(
+                    range, Pack(GetBegin(range) + 1, GetEnd(range)),
+                    std::memory_order_acq_rel, std::memory_order_acquire)) {
+                return GetBegin(range);
+            }
+        }
+
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Move the back half of another worker's range to the worker's own empty range.
+     *
+     * @return Whether any task was stolen.
+     */
+    bool Steal(const std::size_t worker) noexcept {
+        const auto worker_count {GetThreadCount()};
+        for (std::size_t i {1}; i < worker_count; ++i) {
+            auto& bounds {ranges_[(worker + i) % worker_count].bounds};
+            auto range {bounds.load(std::memory_order_acquire)};
+            while (GetBegin(range) < GetEnd(range)) {
+                const auto begin {GetBegin(range)};
+                const auto end {GetEnd(range)};
+                const auto middle {begin + (end - begin) / 2};
+                if (bounds.compare_exchange_weak(range, Pack(begin, middle),
+                                                 std::memory_order_acq_rel,
+                                                 std::memory_order_acquire)) {
+                    ranges_[worker].bounds.store(Pack(middle, end),
+                                                 std::memory_order_release);
+                    return true;
+                }
+            }
+        }
+
+        return false;
+    }
+
+    std::vector<Range> ranges_;
+
+    std::vector<std::thread> threads_;
+
+    const Task* task_ {nullptr};
+
+    //! Increased for each job to wake up workers.
+    std::atomic<std::uint64_t> generation_ {0};
+
+    //! The number of workers, except the calling thread, that have not finished the current job.
+    std::atomic<std::size_t> busy_ {0};
+
+    std::atomic<bool> stopping_ {false};
+};
+
+WorkStealingPool::WorkStealingPool(const std::size_t thread_count) noexcept :
+    impl_ {std::make_unique<Impl>(
+        thread_count != 0
+            ? thread_count
+            : std::max<std::size_t>(std::thread::hardware_concurrency(), 1))} {}
+
+WorkStealingPool::~WorkStealingPool() noexcept = default;
+
+std::size_t WorkStealingPool::GetThreadCount() const noexcept {
+    return impl_->GetThreadCount();
+}
+
+void WorkStealingPool::ParallelFor(const std::size_t count,
+                                   const Task& task) noexcept {
+    impl_->ParallelFor(count, task);
+}
\ No newline at end of file
@@ -0,0 +1,226 @@
+#include "replay.h"
+
+#include <array>
+#include <cassert>
+#include <limits>
+
+
+namespace {
+
+constexpr std::array<char, 4> magic {'T', 'T', 'R', 'P'};
+
+constexpr std::uint8_t version {1};
+
+//! The number of bits of an action in a record.
+constexpr std::size_t action_bits {3};
+
+//! The action code ending the records.
+constexpr std::uint64_t end_code {(1 << action_bits) - 1};
+
+//! The last action that can be recorded.
+constexpr auto last_action {Action::HardDrop};
+
+static_assert(static_cast<std::uint64_t>(last_action) < end_code);
+
+//! Write an unsigned LEB128 varint.
+void WriteVarint(std::ostream& os, std::uint64_t val) noexcept {
+    while (val >= 0x80) {
+        os.put(static_cast<char>((val & 0x7F) | 0x80));
+        val >>= 7;
+    }
+
+    os.put(static_cast<char>(val));
+}
+
+//! Read an unsigned LEB128 varint.
+std::optional<std::uint64_t> ReadVarint(std::istream& is) noexcept {
+    std::uint64_t val {0};
+    for (std::size_t shift {0}; shift < std::numeric_limits<std::uint64_t>::digits;
+         shift += 7) {
+        const auto byte {is.get()};
+        if (byte == std::istream::traits_type::eof()) {
+            return std::nullopt;
+        }
+
+        val |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            return val;
+        }
+    }
+
+    return std::nullopt;
+}
+
+std::optional<ReplayHeader> ReadHeader(std::istream& is) noexcept {
+    std::array<char, magic.size()> file_magic {};
+    if (!is.read(file_magic.data(), file_magic.size()) || file_magic != magic
+        || is.get() != version) {
+        return std::nullopt;
+    }
+
+    std::array<std::uint64_t, 6> fields {};
+    for (auto& field : fields) {
+        if (const auto val {ReadVarint(is)}; val.has_value()) {
+            field = val.value();
+        } else {
+            return std::nullopt;
+        }
+    }
+
+    const auto [width, height, seed, next_count, descend_time, randomizer] {
+        fields};
+    constexpr std::size_t min_size {4};
+    constexpr std::size_t max_size {std::numeric_limits<std::uint16_t>::max()};
+    if (width < min_size || width > max_size || height < min_size
+        || height > max_size || next_count < 1
+        || next_count > GameSettings::max_next_count
+        || randomizer >= static_cast<std::uint64_t>(Randomizer::Custom)) {
+        return std::nullopt;
+    }
+
+    return ReplayHeader {
+        .width = width,
+        .height = height,
+        .seed = seed,
+        .next_count = next_count,
+        .descend_time = std::chrono::duration_cast<
+            std::chrono::steady_clock::duration>(
+            std::chrono::nanoseconds {descend_time}),
+        .randomizer = static_cast<Randomizer>(randomizer)};
+}
+
+//! Tick a game until a number of ticks have elapsed or it is over.
+void TickTo(Game& game, const std::size_t tick) noexcept {
+    while (game.GetTickCount() < tick && !game.IsOver()) {
+        game.Tick();
+    }
+}
+
+}  // namespace
+
+
+GameSettings ReplayHeader::ToSettings() const noexcept {
+    GameSettings settings;
+    settings.SetHeadless(true)
+        .SetSeed(seed)
+        .SetNextCount(next_count)
+        .SetDescendTime(descend_time)
+        .SetRandomizer(randomizer);
+    return settings;
+}
+
+ReplayRecorder::ReplayRecorder(std::ostream& os) noexcept : os_ {os} {}
+
+ReplayRecorder::~ReplayRecorder() noexcept {
+    Finish();
+}
+
+void ReplayRecorder::Attach(Game& game) noexcept {
+    assert(!game_);
+    const auto& settings {game.GetSettings()};
+    assert(settings.GetRandomizer() != Randomizer::Custom);
+
+    const auto grid {game.GetGrid()};
+    os_.write(magic.data(), magic.size());
+    os_.put(static_cast<char>(version));
+    WriteVarint(os_, grid->GetWidth());
+    WriteVarint(os_, grid->GetHeight());
+    WriteVarint(os_, game.GetSeed());
+    WriteVarint(os_, settings.GetNextCount());
+    WriteVarint(os_, std::chrono::duration_cast<std::chrono::nanoseconds>(
+                         settings.GetDescendTime())
+                         .count());
+    WriteVarint(os_, static_cast<std::uint64_t>(settings.GetRandomizer()));
+
+    game_ = &game;
+    last_tick_ = 0;
+    game.SetActionListener([this](const std::size_t tick, const Action action) {
+        Record(tick, action);
+    });
+}
+
+void ReplayRecorder::Record(const std::size_t tick,
+                            const Action action) noexcept {
+    assert(tick >= last_tick_);
+    WriteVarint(os_, (static_cast<std::uint64_t>(tick - last_tick_)
+                      << action_bits)
+                         | static_cast<std::uint64_t>(action));
+    last_tick_ = tick;
+}
+
+void ReplayRecorder::Finish() noexcept {
+    if (!game_) {
+        return;
+    }
+
+    game_->SetActionListener(nullptr);
+    const auto tick {game_->GetTickCount()};
+    WriteVarint(os_, (static_cast<std::uint64_t>(tick - last_tick_)
+                      << action_bits)
+                         | end_code);
+    WriteVarint(os_, game_->GetScore());
+    WriteVarint(os_, game_->GetLineCount());
+    WriteVarint(os_, game_->GetPieceCount());
+    os_.flush();
+    game_ = nullptr;
+}
+
+ReplayTrailer ReplayResult::GetReplayed() const noexcept {
+    assert(game);
+    return {.tick_count = game->GetTickCount(),
+            .score = game->GetScore(),
+            .line_count = game->GetLineCount(),
+            .piece_count = game->GetPieceCount()};
+}
+
+bool ReplayResult::Matched() const noexcept {
+    return GetReplayed() == recorded;
+}
+
+std::optional<ReplayResult> PlayReplay(std::istream& is) noexcept {
+    const auto header {ReadHeader(is)};
+    if (!header.has_value()) {
+        return std::nullopt;
+    }
+
+    ReplayResult result {
+        .game = std::make_unique<Game>(
+            std::make_shared<Grid>(header->width, header->height),
+            header->ToSettings()),
+        .header = header.value(),
+        .recorded = {}};
+    auto& game {*result.game};
+    game.Start();
+
+    std::size_t tick {0};
+    while (true) {
+        const auto record {ReadVarint(is)};
+        if (!record.has_value()) {
+            return std::nullopt;
+        }
+
+        tick += record.value() >> action_bits;
+        TickTo(game, tick);
+        const auto code {record.value() & end_code};
+        if (code == end_code) {
+            break;
+        } else if (code > static_cast<std::uint64_t>(last_action)) {
+            return std::nullopt;
+        }
+
+        game.Act(static_cast<Action>(code));
+    }
+
+    result.recorded.tick_count = tick;
+    for (auto* const field : {&result.recorded.score,
+                              &result.recorded.line_count,
+                              &result.recorded.piece_count}) {
+        if (const auto val {ReadVarint(is)}; val.has_value()) {
+            *field = val.value();
+        } else {
+            return std::nullopt;
+        }
+    }
+
+    return result;
+}
\ No newline at end of file
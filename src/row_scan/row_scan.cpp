@@ -0,0 +1,187 @@
+#include "row_scan.h"
+
+#include <algorithm>
+#include <cassert>
+#include <string_view>
+#include <unordered_map>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define ROW_SCAN_X86
+#include <immintrin.h>
+#endif
+
+
+namespace row_scan {
+
+namespace {
+
+constexpr Word all_ones {~Word {0}};
+
+bool AllSetPortable(const Word* const words, const std::size_t count) noexcept {
+    return std::all_of(words, words + count,
+                       [](const Word word) noexcept { return word == all_ones; });
+}
+
+bool AllClearPortable(const Word* const words,
+                      const std::size_t count) noexcept {
+    return std::all_of(words, words + count,
+                       [](const Word word) noexcept { return word == 0; });
+}
+
+#ifdef ROW_SCAN_X86
+
+constexpr std::size_t avx2_words {sizeof(__m256i) / sizeof(Word)};
+
+__attribute__((target("avx2"))) bool AllSetAVX2(
+    const Word* const words, const std::size_t count) noexcept {
+    const auto ones {_mm256_set1_epi8(-1)};
+    std::size_t i {0};
+    for (; i + avx2_words <= count; i += avx2_words) {
+        const auto row {
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + i))};
+        // Test whether no bit of the row is cleared.
+        if (!_mm256_testc_si256(row, ones)) {
+            return false;
+        }
+    }
+
+    // Calling legacy SSE code with dirty upper halves of AVX registers is slow,
+    // so the remaining words are scanned here.
+    for (; i < count; ++i) {
+        if (words[i] != all_ones) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+__attribute__((target("avx2"))) bool AllClearAVX2(
+    const Word* const words, const std::size_t count) noexcept {
+    std::size_t i {0};
+    for (; i + avx2_words <= count; i += avx2_words) {
+        const auto row {
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + i))};
+        if (!_mm256_testz_si256(row, row)) {
+            return false;
+        }
+    }
+
+    for (; i < count; ++i) {
+        if (words[i] != 0) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+#endif
+
+//! A scan over whole words.
+using Scan = bool (*)(const Word*, std::size_t) noexcept;
+
+Scan GetAllSetScan(const Kernel kernel) noexcept {
+    assert(IsSupported(kernel));
+    switch (kernel) {
+#ifdef ROW_SCAN_X86
+        case Kernel::AVX2: {
+            return AllSetAVX2;
+        }
+#endif
+        default: {
+            return AllSetPortable;
+        }
+    }
+}
+
+Scan GetAllClearScan(const Kernel kernel) noexcept {
+    assert(IsSupported(kernel));
+    switch (kernel) {
+#ifdef ROW_SCAN_X86
+        case Kernel::AVX2: {
+            return AllClearAVX2;
+        }
+#endif
+        default: {
+            return AllClearPortable;
+        }
+    }
+}
+
+//! The scans of the best kernel, selected once.
+struct BestScans {
+    BestScans() noexcept :
+        kernel {IsSupported(Kernel::AVX2) ? Kernel::AVX2 : Kernel::Portable},
+        all_set {GetAllSetScan(kernel)},
+        all_clear {GetAllClearScan(kernel)} {}
+
+    Kernel kernel;
+
+    Scan all_set;
+
+    Scan all_clear;
+};
+
+const BestScans& GetBestScans() noexcept {
+    static const BestScans scans;
+    return scans;
+}
+
+}  // namespace
+
+std::string to_string(const Kernel kernel) noexcept {
+    const static std::unordered_map<Kernel, std::string_view> names {
+        {Kernel::Portable, "Portable"},
+        {Kernel::AVX2, "AVX2"}};
+
+    assert(names.contains(kernel));
+    return names.at(kernel).data();
+}
+
+std::ostream& operator<<(std::ostream& io, const Kernel kernel) noexcept {
+    return io << to_string(kernel);
+}
+
+bool IsSupported(const Kernel kernel) noexcept {
+    switch (kernel) {
+#ifdef ROW_SCAN_X86
+        case Kernel::AVX2: {
+            return __builtin_cpu_supports("avx2");
+        }
+#endif
+        case Kernel::Portable: {
+            return true;
+        }
+        default: {
+            return false;
+        }
+    }
+}
+
+Kernel GetBestKernel() noexcept {
+    return GetBestScans().kernel;
+}
+
+bool AllSet(const Kernel kernel, const std::span<const Word> words,
+            const Word last_mask) noexcept {
+    assert(!words.empty());
+    return words.back() == last_mask
+           && GetAllSetScan(kernel)(words.data(), words.size() - 1);
+}
+
+bool AllSet(const std::span<const Word> words, const Word last_mask) noexcept {
+    assert(!words.empty());
+    return words.back() == last_mask
+           && GetBestScans().all_set(words.data(), words.size() - 1);
+}
+
+bool AllClear(const Kernel kernel, const std::span<const Word> words) noexcept {
+    return GetAllClearScan(kernel)(words.data(), words.size());
+}
+
+bool AllClear(const std::span<const Word> words) noexcept {
+    return GetBestScans().all_clear(words.data(), words.size());
+}
+
+}  // namespace row_scan
\ No newline at end of file
@@ -0,0 +1,82 @@
+#include "runner.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+
+
+void PlayGame(Game& game, Policy& policy,
+              const std::size_t max_actions_per_tick,
+              const std::size_t max_piece_count) noexcept {
+    assert(game.GetSettings().IsHeadless());
+    std::size_t action_count {0};
+    // The piece count includes the current tetromino, which has not been placed yet.
+    while (!game.IsOver() && game.GetPieceCount() <= max_piece_count) {
+        if (const auto action {policy.Decide(game)};
+            action != Action::Non && action_count < max_actions_per_tick) {
+            game.Act(action);
+            ++action_count;
+        } else {
+            game.Tick();
+            action_count = 0;
+        }
+    }
+}
+
+Runner::Runner(const std::size_t width, const std::size_t height,
+               GameSettings settings, PolicyFactory policy_factory) noexcept :
+    width_ {width},
+    height_ {height},
+    settings_ {std::move(settings)},
+    policy_factory_ {std::move(policy_factory)} {
+    assert(policy_factory_);
+    settings_.SetHeadless(true);
+}
+
+Runner& Runner::SetMaxActionsPerTick(const std::size_t count) noexcept {
+    max_actions_per_tick_ = count;
+    return *this;
+}
+
+Runner& Runner::SetMaxPieceCount(const std::size_t count) noexcept {
+    max_piece_count_ = count;
+    return *this;
+}
+
+RunResult Runner::Run(WorkStealingPool& pool, const std::size_t game_count,
+                      const std::uint64_t first_seed) const noexcept {
+    RunResult result;
+    result.games.resize(game_count);
+    std::atomic<std::size_t> score {0}, line_count {0}, piece_count {0},
+        tick_count {0};
+
+    const auto begin {std::chrono::steady_clock::now()};
+    pool.ParallelFor(game_count, [&](const std::size_t i, std::size_t) noexcept {
+        const auto game {Play(first_seed + i)};
+        result.games[i] = game;
+        score.fetch_add(game.score, std::memory_order_relaxed);
+        line_count.fetch_add(game.line_count, std::memory_order_relaxed);
+        piece_count.fetch_add(game.piece_count, std::memory_order_relaxed);
+        tick_count.fetch_add(game.tick_count, std::memory_order_relaxed);
+    });
+
+    result.elapsed = std::chrono::steady_clock::now() - begin;
+    result.score = score.load(std::memory_order_relaxed);
+    result.line_count = line_count.load(std::memory_order_relaxed);
+    result.piece_count = piece_count.load(std::memory_order_relaxed);
+    result.tick_count = tick_count.load(std::memory_order_relaxed);
+    return result;
+}
+
+GameResult Runner::Play(const std::uint64_t seed) const noexcept {
+    auto settings {settings_};
+    settings.SetSeed(seed);
+    Game game {std::make_shared<Grid>(width_, height_), std::move(settings)};
+    const auto policy {policy_factory_(seed)};
+    assert(policy);
+
+    game.Start();
+    PlayGame(game, *policy, max_actions_per_tick_, max_piece_count_);
+    return {seed, game.GetScore(), game.GetLineCount(), game.GetPieceCount(),
+            game.GetTickCount()};
+}
\ No newline at end of file
@@ -0,0 +1,170 @@
+/**
+ * @file main.cpp
+ * @brief The headless batch simulator.
+ *
+ * @author Chen Zhenshuo (chenzs108@outlook.com)
+ * @par GitHub
+ * https://github.com/Zhuagenborn
+ * @version 1.0
+ * @date 2023-05-03
+ */
+
+#include "args.h"
+#include "policy.h"
+#include "pool.h"
+#include "replay.h"
+#include "runner.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+
+namespace {
+
+//! Get the throughput of a run.
+double GetPerSecond(const std::size_t count, const RunResult& result) noexcept {
+    const std::chrono::duration<double> elapsed {result.elapsed};
+    return elapsed.count() > 0 ? count / elapsed.count() : 0;
+}
+
+void PrintResult(const RunResult& result) noexcept {
+    std::cout << "Games: " << result.games.size() << '\n'
+              << "Pieces: " << result.piece_count << '\n'
+              << "Lines: " << result.line_count << '\n'
+              << "Score: " << result.score << '\n'
+              << "Seconds: "
+              << std::chrono::duration<double> {result.elapsed}.count() << '\n'
+              << "Games/sec: " << GetPerSecond(result.games.size(), result)
+              << '\n'
+              << "Pieces/sec: " << GetPerSecond(result.piece_count, result)
+              << std::endl;
+}
+
+/**
+ * @brief Run the same games with 1, 2, 4, ... threads up to the hardware limit,
+ * and print the throughput and speedup of each.
+ */
+void PrintScaling(const Runner& runner, const std::size_t game_count,
+                  const std::uint64_t seed) noexcept {
+    const auto max_thread_count {
+        std::max<std::size_t>(std::thread::hardware_concurrency(), 1)};
+    std::cout << std::setw(8) << "Threads" << std::setw(14) << "Games/sec"
+              << std::setw(14) << "Pieces/sec" << std::setw(10) << "Speedup"
+              << '\n';
+
+    double base {0};
+    for (std::size_t thread_count {1};; thread_count *= 2) {
+        thread_count = std::min(thread_count, max_thread_count);
+        WorkStealingPool pool {thread_count};
+        const auto result {runner.Run(pool, game_count, seed)};
+        const auto games_per_sec {GetPerSecond(game_count, result)};
+        if (thread_count == 1) {
+            base = games_per_sec;
+        }
+
+        std::cout << std::setw(8) << thread_count << std::setw(14)
+                  << std::fixed << std::setprecision(1) << games_per_sec
+                  << std::setw(14) << GetPerSecond(result.piece_count, result)
+                  << std::setw(10) << std::setprecision(2)
+                  << (base > 0 ? games_per_sec / base : 0) << std::endl;
+
+        if (thread_count == max_thread_count) {
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Play a replay and print whether the replayed game matches the recording.
+ *
+ * @return Whether the replay matches.
+ */
+bool PrintReplay(const std::string& path) {
+    std::ifstream file {path, std::ios::binary};
+    if (!file) {
+        throw std::runtime_error {"Failed to open the replay."};
+    }
+
+    const auto begin {std::chrono::steady_clock::now()};
+    const auto result {PlayReplay(file)};
+    const std::chrono::duration<double> elapsed {std::chrono::steady_clock::now()
+                                                 - begin};
+    if (!result.has_value()) {
+        throw std::runtime_error {"The replay is malformed."};
+    }
+
+    const auto replayed {result->GetReplayed()};
+    std::cout << "Seed: " << result->header.seed << '\n'
+              << "Randomizer: " << result->header.randomizer << '\n'
+              << "Ticks: " << replayed.tick_count << '\n'
+              << "Pieces: " << replayed.piece_count << '\n'
+              << "Lines: " << replayed.line_count << '\n'
+              << "Score: " << replayed.score << '\n'
+              << "Seconds: " << elapsed.count() << '\n'
+              << "Matched: " << std::boolalpha << result->Matched()
+              << std::endl;
+    return result->Matched();
+}
+
+}  // namespace
+
+
+int main(int, char* argv[]) {
+    try {
+        CmdArgs args;
+        args.Parse(argv);
+
+        if (const auto path {args.GetReplayPath()}; !path.empty()) {
+            return PrintReplay(path) ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+
+        constexpr std::size_t min_width {10}, min_height {15};
+        const auto width {std::max(args.GetWidth(), min_width)};
+        const auto height {std::max(args.GetHeight(), min_height)};
+        const auto game_count {std::max<std::size_t>(args.GetGameCount(), 1)};
+
+        GameSettings settings;
+        if (const auto count {args.GetNextCount()}; count > 0) {
+            settings.SetNextCount(count);
+        }
+
+        // Games run in parallel, so each beam search runs in its own worker.
+        const auto autoplay {args.IsAutoplay()};
+        const auto beam_width {args.GetBeamWidth()};
+        Runner runner {
+            width, height, std::move(settings),
+            [autoplay, beam_width](const std::uint64_t seed) noexcept
+            -> std::unique_ptr<Policy> {
+                if (autoplay && beam_width > 0) {
+                    auto policy {std::make_unique<BeamSearchPolicy>()};
+                    policy->SetBeamWidth(beam_width);
+                    return policy;
+                } else if (autoplay) {
+                    return std::make_unique<HeuristicPolicy>();
+                } else {
+                    return std::make_unique<RandomPolicy>(seed);
+                }
+            }};
+        if (const auto count {args.GetPieceCount()}; count > 0) {
+            runner.SetMaxPieceCount(count);
+        }
+
+        if (args.IsScaling()) {
+            PrintScaling(runner, game_count, args.GetSeed());
+        } else {
+            WorkStealingPool pool {args.GetThreadCount()};
+            PrintResult(runner.Run(pool, game_count, args.GetSeed()));
+        }
+
+        return EXIT_SUCCESS;
+    } catch (const std::exception& err) {
+        std::cerr << err.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+}
\ No newline at end of file
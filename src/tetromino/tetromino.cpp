@@ -7,6 +7,7 @@
 #include "subtype/t.h"
 #include "subtype/z.h"
 
+#include <algorithm>
 #include <cassert>
 #include <chrono>
 #include <random>
@@ -50,15 +51,19 @@ void Tetromino::SetColor(const Color color) noexcept {
 }
 
 std::size_t Tetromino::GetHeight() const noexcept {
-    return GetShape().GetHeight();
+    return GetShapeMask().height;
 }
 
 std::size_t Tetromino::GetWidth() const noexcept {
-    return GetShape().GetWidth();
+    return GetShapeMask().width;
 }
 
 bool Tetromino::Filled(const Point& pos) const noexcept {
-    return GetShape().Filled(pos);
+    return GetShapeMask().Filled(pos);
+}
+
+const tetromino::ShapeMask& Tetromino::GetShapeMask() const noexcept {
+    return tetromino::GetShapeMask(GetType(), GetAngle());
 }
 
 const Shape& Tetromino::GetShape() const noexcept {
@@ -67,6 +72,103 @@ const Shape& Tetromino::GetShape() const noexcept {
 
 namespace tetromino {
 
+namespace {
+
+//! Generate the layout of a shape at compile time.
+template <std::derived_from<Shape> S>
+consteval ShapeMask MakeShapeMask() noexcept {
+    const auto& cells {S::GetCells()};
+    const auto width {cells.size()};
+    const auto height {cells[0].size()};
+    ShapeMask mask {width, height, {}, {}, {}};
+    std::size_t count {0};
+    for (std::size_t y {0}; y < height; ++y) {
+        for (std::size_t x {0}; x < width; ++x) {
+            if (cells[x][y]) {
+                mask.rows[y] |= static_cast<std::uint8_t>(1 << x);
+                mask.cells[count++] = {x, y};
+                mask.bottoms[x] = static_cast<std::uint8_t>(y);
+            }
+        }
+    }
+
+    return mask;
+}
+
+//! Generate the layouts of a tetromino type from @p Degree0 to @p Degree270.
+template <typename Degree0, typename Degree90, typename Degree180,
+          typename Degree270>
+consteval std::array<ShapeMask, angle_count> MakeShapeMasks() noexcept {
+    return {MakeShapeMask<Degree0>(), MakeShapeMask<Degree90>(),
+            MakeShapeMask<Degree180>(), MakeShapeMask<Degree270>()};
+}
+
+//! The layouts of all tetromino types at all angles, indexed by @p Type and @p Angle.
+constexpr std::array<std::array<ShapeMask, angle_count>, type_count>
+    shape_masks {
+        MakeShapeMasks<shape::i::Degree0, shape::i::Degree90,
+                       shape::i::Degree0, shape::i::Degree90>(),
+        MakeShapeMasks<shape::j::Degree0, shape::j::Degree90,
+                       shape::j::Degree180, shape::j::Degree270>(),
+        MakeShapeMasks<shape::l::Degree0, shape::l::Degree90,
+                       shape::l::Degree180, shape::l::Degree270>(),
+        MakeShapeMasks<shape::O, shape::O, shape::O, shape::O>(),
+        MakeShapeMasks<shape::s::Degree0, shape::s::Degree90,
+                       shape::s::Degree0, shape::s::Degree90>(),
+        MakeShapeMasks<shape::t::Degree0, shape::t::Degree90,
+                       shape::t::Degree180, shape::t::Degree270>(),
+        MakeShapeMasks<shape::z::Degree0, shape::z::Degree90,
+                       shape::z::Degree0, shape::z::Degree90>(),
+    };
+
+static_assert(static_cast<std::size_t>(Type::Z) + 1 == type_count);
+
+// Each layout must have exactly four filled cells.
+// An extra cell fails the generation and a missing one leaves the last cell at the origin.
+static_assert(std::ranges::all_of(shape_masks, [](const auto& masks) {
+    return std::ranges::all_of(masks, [](const ShapeMask& mask) {
+        return mask.cells[cell_count - 1].x != 0
+               || mask.cells[cell_count - 1].y != 0;
+    });
+}));
+
+//! Whether two layouts are the same.
+constexpr bool SameLayout(const ShapeMask& lhs, const ShapeMask& rhs) noexcept {
+    return lhs.width == rhs.width && lhs.height == rhs.height
+           && lhs.rows == rhs.rows;
+}
+
+//! The number of distinct layouts of each type, the smallest period of its rotations.
+constexpr auto rotation_counts {[] {
+    std::array<std::size_t, type_count> counts {};
+    for (std::size_t i {0}; i < type_count; ++i) {
+        const auto& masks {shape_masks[i]};
+        counts[i] = SameLayout(masks[1], masks[0])   ? 1
+                    : SameLayout(masks[2], masks[0]) ? 2
+                                                     : angle_count;
+    }
+
+    return counts;
+}()};
+
+static_assert(rotation_counts[static_cast<std::size_t>(Type::O)] == 1);
+static_assert(rotation_counts[static_cast<std::size_t>(Type::I)] == 2);
+static_assert(rotation_counts[static_cast<std::size_t>(Type::T)] == 4);
+
+}  // namespace
+
+std::size_t GetRotationCount(const Type type) noexcept {
+    assert(static_cast<std::size_t>(type) < type_count);
+    return rotation_counts[static_cast<std::size_t>(type)];
+}
+
+const ShapeMask& GetShapeMask(const Type type, const Angle angle) noexcept {
+    assert(static_cast<std::size_t>(type) < type_count);
+    assert(static_cast<std::size_t>(angle) < angle_count);
+    return shape_masks[static_cast<std::size_t>(type)]
+                      [static_cast<std::size_t>(angle)];
+}
+
 /**
  * @brief Implement the @p GetShape method for a tetromino type with two types of rotated shapes.
  *
@@ -124,11 +226,10 @@ namespace tetromino {
     }
 
 Type GetRandomType() noexcept {
-    using TypeInt = std::underlying_type_t<Type>;
-    static std::default_random_engine eng {static_cast<unsigned>(
+    thread_local std::default_random_engine eng {static_cast<unsigned>(
         std::chrono::system_clock::now().time_since_epoch().count())};
-    static std::uniform_int_distribution dist(static_cast<TypeInt>(Type::I),
-                                              static_cast<TypeInt>(Type::Z));
+    thread_local std::uniform_int_distribution dist(static_cast<int>(Type::I),
+                                                    static_cast<int>(Type::Z));
     return static_cast<Type>(dist(eng));
 }
 
@@ -0,0 +1,175 @@
+#include "timer_wheel.h"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+
+
+TimerWheel::TimerWheel(const Clock::duration resolution,
+                       const Clock::time_point origin) noexcept :
+    resolution_ {resolution}, origin_ {origin} {
+    assert(resolution_ > Clock::duration::zero());
+    slots_.fill(npos);
+}
+
+std::uint64_t TimerWheel::ToTick(const Clock::time_point time) const noexcept {
+    if (time <= origin_) {
+        return 0;
+    } else {
+        return static_cast<std::uint64_t>(
+            (time - origin_ + resolution_ - Clock::duration {1})
+            / resolution_);
+    }
+}
+
+void TimerWheel::Schedule(const std::size_t id,
+                          const Clock::time_point deadline) noexcept {
+    if (id >= timers_.size()) {
+        timers_.resize(id + 1);
+    } else if (timers_[id].slot != npos) {
+        Unlink(id);
+    }
+
+    timers_[id].tick = std::max(ToTick(deadline), current_ + 1);
+    Link(id);
+}
+
+void TimerWheel::Cancel(const std::size_t id) noexcept {
+    if (IsScheduled(id)) {
+        Unlink(id);
+    }
+}
+
+bool TimerWheel::IsScheduled(const std::size_t id) const noexcept {
+    return id < timers_.size() && timers_[id].slot != npos;
+}
+
+std::size_t TimerWheel::GetSize() const noexcept {
+    return size_;
+}
+
+void TimerWheel::Link(const std::size_t id) noexcept {
+    auto& timer {timers_[id]};
+    assert(timer.tick >= current_);
+
+    // The lowest level whose slots cover the distance to the deadline.
+    auto tick {timer.tick};
+    const auto distance {tick - current_};
+    auto level {distance < slot_count
+                    ? 0
+                    : (std::bit_width(distance) - 1) / slot_bits};
+    if (level >= level_count) {
+        // Park a far deadline in the farthest slot, and link it again when the slot is reached.
+        level = level_count - 1;
+        tick = current_ + (std::uint64_t {1} << (slot_bits * level_count)) - 1;
+    }
+
+    const auto pos {(tick >> (slot_bits * level)) & (slot_count - 1)};
+    timer.slot = level * slot_count + pos;
+    timer.prev = npos;
+    timer.next = slots_[timer.slot];
+    if (timer.next != npos) {
+        timers_[timer.next].prev = id;
+    }
+
+    slots_[timer.slot] = id;
+    occupied_[level] |= std::uint64_t {1} << pos;
+    ++size_;
+}
+
+void TimerWheel::Unlink(const std::size_t id) noexcept {
+    auto& timer {timers_[id]};
+    assert(timer.slot != npos);
+    if (timer.prev != npos) {
+        timers_[timer.prev].next = timer.next;
+    } else {
+        slots_[timer.slot] = timer.next;
+        if (timer.next == npos) {
+            occupied_[timer.slot / slot_count] &=
+                ~(std::uint64_t {1} << (timer.slot % slot_count));
+        }
+    }
+
+    if (timer.next != npos) {
+        timers_[timer.next].prev = timer.prev;
+    }
+
+    timer.slot = npos;
+    --size_;
+}
+
+std::uint64_t TimerWheel::GetNextEventTick() const noexcept {
+    auto next {UINT64_MAX};
+    for (std::size_t level {0}; level < level_count; ++level) {
+        if (occupied_[level] == 0) {
+            continue;
+        }
+
+        // Slots are reached in a circle starting after the current one.
+        const auto shift {slot_bits * level};
+        const auto block {(current_ >> shift) + 1};
+        const auto offset {std::countr_zero(std::rotr(
+            occupied_[level], static_cast<int>(block & (slot_count - 1))))};
+        next = std::min(next, (block + offset) << shift);
+    }
+
+    return next;
+}
+
+std::optional<TimerWheel::Clock::time_point> TimerWheel::GetNextWakeUpTime()
+    const noexcept {
+    if (size_ == 0) {
+        return std::nullopt;
+    } else {
+        return origin_
+               + resolution_ * static_cast<Clock::rep>(GetNextEventTick());
+    }
+}
+
+void TimerWheel::Advance(
+    const Clock::time_point now,
+    const std::function<void(std::size_t id)>& expire) noexcept {
+    const auto target {now <= origin_ ? 0
+                                      : static_cast<std::uint64_t>(
+                                          (now - origin_) / resolution_)};
+    while (current_ < target) {
+        // Skip the ticks where nothing happens.
+        const auto next {size_ == 0 ? UINT64_MAX : GetNextEventTick()};
+        if (next > target) {
+            current_ = target;
+            break;
+        }
+
+        current_ = next - 1;
+        Step(expire);
+    }
+}
+
+void TimerWheel::Step(
+    const std::function<void(std::size_t id)>& expire) noexcept {
+    ++current_;
+
+    // Move timers down from the higher levels whose slots are reached.
+    // The ones expiring at the current tick are moved into the slot expired below.
+    for (auto level {level_count - 1}; level > 0; --level) {
+        const auto shift {slot_bits * level};
+        if ((current_ & ((std::uint64_t {1} << shift) - 1)) != 0) {
+            continue;
+        }
+
+        const auto slot {level * slot_count
+                         + ((current_ >> shift) & (slot_count - 1))};
+        while (slots_[slot] != npos) {
+            const auto id {slots_[slot]};
+            Unlink(id);
+            Link(id);
+        }
+    }
+
+    const auto slot {current_ & (slot_count - 1)};
+    while (slots_[slot] != npos) {
+        const auto id {slots_[slot]};
+        Unlink(id);
+        expire(id);
+    }
+}
\ No newline at end of file
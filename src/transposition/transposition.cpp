@@ -0,0 +1,45 @@
+#include "transposition.h"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cmath>
+
+
+TranspositionTable::TranspositionTable(const std::size_t capacity) noexcept :
+    mask_ {std::bit_ceil(std::max<std::size_t>(capacity, 1)) - 1},
+    entries_ {std::make_unique<Entry[]>(mask_ + 1)} {
+    Clear();
+}
+
+std::size_t TranspositionTable::GetCapacity() const noexcept {
+    return mask_ + 1;
+}
+
+std::optional<double> TranspositionTable::Find(
+    const std::uint64_t hash) const noexcept {
+    const auto& entry {entries_[hash & mask_]};
+    const auto check {entry.check.load(std::memory_order_relaxed)};
+    const auto data {entry.data.load(std::memory_order_relaxed)};
+    if ((check ^ data) == hash && data != empty_data_) {
+        return std::bit_cast<double>(data);
+    } else {
+        return std::nullopt;
+    }
+}
+
+void TranspositionTable::Insert(const std::uint64_t hash,
+                                const double value) noexcept {
+    assert(!std::isnan(value));
+    auto& entry {entries_[hash & mask_]};
+    const auto data {std::bit_cast<std::uint64_t>(value)};
+    entry.check.store(hash ^ data, std::memory_order_relaxed);
+    entry.data.store(data, std::memory_order_relaxed);
+}
+
+void TranspositionTable::Clear() noexcept {
+    for (std::size_t i {0}; i <= mask_; ++i) {
+        entries_[i].check.store(0, std::memory_order_relaxed);
+        entries_[i].data.store(empty_data_, std::memory_order_relaxed);
+    }
+}
\ No newline at end of file
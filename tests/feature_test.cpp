@@ -0,0 +1,197 @@
+#include "feature.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace testing;
+
+
+namespace {
+
+//! Compute board features cell by cell.
+BoardFeatures ExtractByCells(const std::vector<std::vector<bool>>& cells) {
+    const auto height {cells.size()};
+    const auto width {cells.front().size()};
+    const auto filled {[&](const std::ptrdiff_t x, const std::size_t y) {
+        return x < 0 || x >= static_cast<std::ptrdiff_t>(width) || cells[y][x];
+    }};
+
+    BoardFeatures features {};
+    std::vector<std::size_t> heights(width);
+    for (std::size_t x {0}; x < width; ++x) {
+        auto top {height};
+        for (std::size_t y {0}; y < height; ++y) {
+            if (cells[y][x]) {
+                top = std::min(top, y);
+            } else if (top < y) {
+                ++features.holes;
+            }
+        }
+
+        heights[x] = height - top;
+        features.aggregate_height += heights[x];
+        features.max_height = std::max(features.max_height, heights[x]);
+
+        auto above {false};
+        for (std::size_t y {0}; y < height; ++y) {
+            features.column_transitions += cells[y][x] != above;
+            above = cells[y][x];
+        }
+
+        features.column_transitions += !above;
+
+        std::size_t depth {0};
+        for (std::size_t y {0}; y < top; ++y) {
+            const auto i {static_cast<std::ptrdiff_t>(x)};
+            if (filled(i - 1, y) && filled(i + 1, y)) {
+                features.wells += ++depth;
+            } else {
+                depth = 0;
+            }
+        }
+    }
+
+    for (std::size_t x {1}; x < width; ++x) {
+        features.bumpiness += heights[x] > heights[x - 1]
+                                  ? heights[x] - heights[x - 1]
+                                  : heights[x - 1] - heights[x];
+    }
+
+    for (std::size_t y {0}; y < height; ++y) {
+        const auto last {static_cast<std::ptrdiff_t>(width)};
+        for (std::ptrdiff_t x {0}; x <= last; ++x) {
+            features.row_transitions += filled(x - 1, y) != filled(x, y);
+        }
+
+        features.completed_lines +=
+            std::ranges::all_of(cells[y], [](const bool cell) { return cell; });
+    }
+
+    return features;
+}
+
+std::vector<std::vector<bool>> GetCells(const Grid& grid) {
+    std::vector<std::vector<bool>> cells(grid.GetHeight(),
+                                         std::vector<bool>(grid.GetWidth()));
+    for (std::size_t y {0}; y < grid.GetHeight(); ++y) {
+        for (std::size_t x {0}; x < grid.GetWidth(); ++x) {
+            cells[y][x] = grid.Filled({x, y});
+        }
+    }
+
+    return cells;
+}
+
+}  // namespace
+
+TEST(FeatureTest, Extract) {
+    constexpr std::size_t width {5};
+    constexpr std::size_t height {5};
+    Grid grid(width, height);
+    EXPECT_EQ(ExtractFeatures(grid),
+              (BoardFeatures {.aggregate_height {0},
+                              .max_height {0},
+                              .holes {0},
+                              .bumpiness {0},
+                              .row_transitions {2 * height},
+                              .column_transitions {width},
+                              .wells {0},
+                              .completed_lines {0}}));
+
+    /*
+        . . . . .
+        . . . . .
+        . . . . .
+        O O . . .
+        O O . . .
+    */
+    std::size_t cleared_line_count {0};
+    ASSERT_TRUE(grid.PushTetromino(Piece {tetromino::Type::O}, Point {0, 0}));
+    grid.TetrominoHardDrop(cleared_line_count);
+    const auto features {ExtractFeatures(grid)};
+    EXPECT_EQ(features.aggregate_height, 4);
+    EXPECT_EQ(features.max_height, 2);
+    EXPECT_EQ(features.holes, 0);
+    EXPECT_EQ(features.bumpiness, 2);
+    EXPECT_EQ(features.row_transitions, 2 * 5);
+    EXPECT_EQ(features.column_transitions, 2 + 3);
+    EXPECT_EQ(features.wells, 0);
+    EXPECT_EQ(features.completed_lines, 0);
+
+    /*
+        . . . . .
+        . . . . .
+        . I I I I
+        O O . . .
+        O O . . .
+    */
+    // A placed piece counts as fixed, which leaves the first column as a well.
+    const Piece placed {tetromino::Type::I, Angle::Degree90, Color::Non,
+                        Point {1, height - 3}};
+    const auto with_placed {ExtractFeatures(grid, placed)};
+    EXPECT_EQ(with_placed.aggregate_height, 2 + 3 * 4);
+    EXPECT_EQ(with_placed.max_height, 3);
+    EXPECT_EQ(with_placed.holes, 3 * 2);
+    EXPECT_EQ(with_placed.bumpiness, 1);
+    EXPECT_EQ(with_placed.wells, 1);
+    EXPECT_EQ(with_placed.completed_lines, 0);
+
+    // The lines completed by a placed piece are counted before being cleared.
+    Grid narrow(4, height);
+    ASSERT_TRUE(narrow.PushTetromino(Piece {tetromino::Type::O}, Point {0, 0}));
+    narrow.TetrominoHardDrop(cleared_line_count);
+    EXPECT_EQ(ExtractFeatures(narrow, Piece {tetromino::Type::O, Angle::Degree0,
+                                             Color::Non, Point {2, height - 2}})
+                  .completed_lines,
+              2);
+}
+
+TEST(FeatureTest, ExtractAgainstModel) {
+    FeatureExtractor extractor;
+    std::mt19937 eng {2};
+    // Cover rows spanning several words whose last word is partial or full.
+    for (const std::size_t width : {4, 10, 63, 64, 65, 130}) {
+        const std::size_t height {16};
+        Grid grid(width, height);
+        std::vector<Grid> candidates;
+        for (std::size_t i {0}; i < 200; ++i) {
+            const auto type {static_cast<tetromino::Type>(
+                std::uniform_int_distribution<int> {0, 6}(eng))};
+            const auto angle {static_cast<Angle>(
+                std::uniform_int_distribution<int> {0, 3}(eng))};
+            const auto& mask {tetromino::GetShapeMask(type, angle)};
+            const Point pos {std::uniform_int_distribution<std::size_t> {
+                                 0, width - mask.width}(eng),
+                             0};
+            // Take the cells before the current tetromino is pushed, as it is ignored.
+            auto cells {GetCells(grid)};
+            if (!grid.PushTetromino(Piece {type, angle}, pos)) {
+                grid.Reset();
+                continue;
+            }
+
+            // Evaluate the piece in its landing position before it is fixed.
+            const auto drop_pos {grid.GetDropPosition()};
+            for (const auto& cell : mask.cells) {
+                cells[drop_pos.y + cell.y][drop_pos.x + cell.x] = true;
+            }
+
+            const Piece placed {type, angle, Color::Non, drop_pos};
+            ASSERT_EQ(extractor.Extract(grid, placed), ExtractByCells(cells));
+
+            std::size_t cleared_line_count {0};
+            grid.TetrominoHardDrop(cleared_line_count);
+            ASSERT_EQ(extractor.Extract(grid), ExtractByCells(GetCells(grid)));
+            candidates.push_back(grid.Fork());
+        }
+
+        const auto features {extractor.Extract(candidates)};
+        ASSERT_EQ(features.size(), candidates.size());
+        for (std::size_t i {0}; i < candidates.size(); ++i) {
+            EXPECT_EQ(features[i], ExtractByCells(GetCells(candidates[i])));
+        }
+    }
+}
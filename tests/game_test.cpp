@@ -0,0 +1,296 @@
+#include "game.h"
+#include "scheduler.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace testing;
+
+
+TEST(GameTest, Headless) {
+    constexpr std::size_t width {10};
+    constexpr std::size_t height {15};
+    GameSettings settings;
+    settings.SetHeadless(true);
+    Game game {std::make_shared<Grid>(width, height), settings};
+
+    game.Start();
+    EXPECT_FALSE(game.IsOver());
+    EXPECT_EQ(game.GetPieceCount(), 1);
+    EXPECT_EQ(game.GetTickCount(), 0);
+
+    // Without any movement, tetrominoes pile up under the entrance until the game is over.
+    std::size_t tick_count {0};
+    while (game.Tick() != ActionResult::GameOver) {
+        ++tick_count;
+        ASSERT_LT(tick_count, width * height);
+    }
+
+    EXPECT_TRUE(game.IsOver());
+    EXPECT_EQ(game.GetTickCount(), tick_count + 1);
+    EXPECT_GT(game.GetPieceCount(), 1);
+    EXPECT_EQ(game.Act(Action::MoveToLeft), ActionResult::GameOver);
+    EXPECT_EQ(game.Tick(), ActionResult::GameOver);
+    EXPECT_EQ(game.GetTickCount(), tick_count + 1);
+}
+
+TEST(GameTest, BeforeStart) {
+    constexpr std::size_t width {10};
+    constexpr std::size_t height {15};
+    for (const auto headless : {true, false}) {
+        GameSettings settings;
+        settings.SetHeadless(headless);
+        const Game game {std::make_shared<Grid>(width, height), settings};
+        EXPECT_TRUE(game.IsOver());
+        EXPECT_EQ(game.GetScore(), 0);
+        EXPECT_EQ(game.GetLineCount(), 0);
+        EXPECT_EQ(game.GetTickCount(), 0);
+        EXPECT_EQ(game.GetPieceCount(), 0);
+        EXPECT_TRUE(game.GetNextTetrominoes().empty());
+        ASSERT_NE(game.GetState(), nullptr);
+        EXPECT_TRUE(game.GetState()->over);
+    }
+}
+
+TEST(GameTest, Seed) {
+    constexpr std::size_t width {10};
+    constexpr std::size_t height {15};
+    constexpr std::uint64_t seed {42};
+    GameSettings settings;
+    settings.SetHeadless(true).SetSeed(seed).SetNextCount(3);
+    Game game1 {std::make_shared<Grid>(width, height), settings};
+    Game game2 {std::make_shared<Grid>(width, height), settings};
+
+    game1.Start();
+    game2.Start();
+    EXPECT_EQ(game1.GetSeed(), seed);
+    while (!game1.IsOver()) {
+        const auto next1 {game1.GetNextTetrominoes()};
+        const auto next2 {game2.GetNextTetrominoes()};
+        ASSERT_EQ(next1.size(), next2.size());
+        for (std::size_t i {0}; i < next1.size(); ++i) {
+            EXPECT_EQ(next1[i].GetType(), next2[i].GetType());
+            EXPECT_EQ(next1[i].GetColor(), next2[i].GetColor());
+        }
+
+        EXPECT_EQ(game1.Tick(), game2.Tick());
+    }
+
+    EXPECT_TRUE(game2.IsOver());
+    EXPECT_EQ(game1.GetPieceCount(), game2.GetPieceCount());
+}
+
+TEST(GameTest, HardDrop) {
+    constexpr std::size_t width {10};
+    constexpr std::size_t height {15};
+    GameSettings settings;
+    settings.SetHeadless(true).SetSeed(0);
+    Game game {std::make_shared<Grid>(width, height), settings};
+
+    game.Start();
+    EXPECT_EQ(game.Act(Action::HardDrop), ActionResult::TetrominoFixed);
+    EXPECT_EQ(game.GetPieceCount(), 2);
+    EXPECT_EQ(game.GetTickCount(), 0);
+
+    // Tetrominoes pile up under the entrance without any gravity.
+    std::size_t drop_count {1};
+    while (game.Act(Action::HardDrop) != ActionResult::GameOver) {
+        ++drop_count;
+        ASSERT_LT(drop_count, height);
+    }
+
+    EXPECT_TRUE(game.IsOver());
+    EXPECT_EQ(game.GetTickCount(), 0);
+}
+
+TEST(GameTest, Post) {
+    constexpr std::size_t width {10};
+    constexpr std::size_t height {15};
+    constexpr std::size_t producer_count {4};
+    GameSettings settings;
+    settings.SetSeed(0).SetDescendTime(std::chrono::hours {1});
+
+    auto headless_settings {settings};
+    headless_settings.SetHeadless(true);
+    Game headless {std::make_shared<Grid>(width, height), headless_settings};
+    headless.Start();
+    while (headless.Act(Action::HardDrop) != ActionResult::GameOver) {
+    }
+
+    Game game {std::make_shared<Grid>(width, height), settings};
+    game.Start();
+    const auto initial_state {game.GetState()};
+    EXPECT_FALSE(initial_state->over);
+    EXPECT_EQ(initial_state->piece_count, 1);
+
+    // Producers race to hard drop tetrominoes, which the game loop executes one by one.
+    std::vector<std::jthread> producers;
+    for (std::size_t i {0}; i < producer_count; ++i) {
+        producers.emplace_back([&game]() {
+            while (!game.IsOver()) {
+                if (!game.Post(Action::HardDrop)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    producers.clear();
+    const auto state {game.GetState()};
+    EXPECT_TRUE(state->over);
+    EXPECT_EQ(state->piece_count, headless.GetPieceCount());
+    EXPECT_EQ(state->tick_count, 0);
+    EXPECT_EQ(state->grid.GetHash(), headless.GetGrid()->GetHash());
+
+    // A published snapshot never changes.
+    EXPECT_FALSE(initial_state->over);
+    EXPECT_EQ(initial_state->piece_count, 1);
+    EXPECT_EQ(initial_state->grid.GetHash(), 0);
+}
+
+TEST(GameTest, GameLoop) {
+    constexpr std::size_t width {10};
+    constexpr std::size_t height {15};
+    GameSettings settings;
+    settings.SetDescendTime(std::chrono::microseconds {100});
+    Game game {std::make_shared<Grid>(width, height), settings};
+
+    // Without any action, the game loop descends tetrominoes until the game is over.
+    game.Start();
+    while (!game.IsOver()) {
+        std::this_thread::yield();
+    }
+
+    EXPECT_GT(game.GetTickCount(), 0);
+    EXPECT_GT(game.GetPieceCount(), 1);
+}
+
+TEST(GameTest, Scheduler) {
+    constexpr std::size_t width {10};
+    constexpr std::size_t height {15};
+    constexpr std::size_t game_count {1000};
+    constexpr std::size_t capacity {game_count - 10};
+    const auto scheduler {std::make_shared<GravityScheduler>(
+        capacity, std::chrono::microseconds {100})};
+    ASSERT_EQ(scheduler->GetCapacity(), capacity);
+
+    GameSettings settings;
+    settings.SetDescendTime(std::chrono::microseconds {500})
+        .SetScheduler(scheduler);
+
+    // Games beyond the capacity of the scheduler run their own game loops.
+    std::vector<std::unique_ptr<Game>> games;
+    for (std::size_t i {0}; i < game_count; ++i) {
+        games.push_back(std::make_unique<Game>(
+            std::make_shared<Grid>(width, height), settings));
+        games.back()->Start();
+    }
+
+    EXPECT_EQ(scheduler->GetGameCount(), capacity);
+    for (const auto& game : games) {
+        while (!game->IsOver()) {
+            std::this_thread::yield();
+        }
+
+        EXPECT_GT(game->GetTickCount(), 0);
+        EXPECT_GT(game->GetPieceCount(), 1);
+    }
+
+    games.clear();
+    EXPECT_EQ(scheduler->GetGameCount(), 0);
+}
+
+TEST(GameTest, SetDescendTime) {
+    constexpr std::size_t width {10};
+    constexpr std::size_t height {15};
+    const auto scheduler {std::make_shared<GravityScheduler>(1)};
+    for (const auto& shared : {scheduler, std::shared_ptr<GravityScheduler> {}}) {
+        GameSettings settings;
+        settings.SetDescendTime(std::chrono::hours {1}).SetScheduler(shared);
+        Game game {std::make_shared<Grid>(width, height), settings};
+        game.Start();
+        EXPECT_FALSE(game.IsOver());
+
+        // The next descent is rescheduled without restarting the game loop.
+        game.SetDescendTime(std::chrono::microseconds {100});
+        EXPECT_EQ(game.GetDescendTime(), std::chrono::microseconds {100});
+        while (!game.IsOver()) {
+            std::this_thread::yield();
+        }
+
+        EXPECT_GT(game.GetPieceCount(), 1);
+    }
+}
+
+TEST(GameTest, StopAndRestart) {
+    constexpr std::size_t width {10};
+    constexpr std::size_t height {15};
+    const auto scheduler {std::make_shared<GravityScheduler>(1)};
+    for (const auto& shared : {scheduler, std::shared_ptr<GravityScheduler> {}}) {
+        GameSettings settings;
+        settings.SetSeed(0)
+            .SetDescendTime(std::chrono::hours {1})
+            .SetScheduler(shared);
+        Game game {std::make_shared<Grid>(width, height), settings};
+
+        for (std::size_t round {0}; round < 3; ++round) {
+            game.Start();
+            EXPECT_FALSE(game.IsOver());
+            EXPECT_EQ(game.GetPieceCount(), 1);
+            EXPECT_EQ(scheduler->GetGameCount(), shared ? 1 : 0);
+
+            ASSERT_TRUE(game.Post(Action::HardDrop));
+            while (game.GetPieceCount() == 1) {
+                std::this_thread::yield();
+            }
+
+            // Stopping does not wait for the next descent.
+            const auto begin {std::chrono::steady_clock::now()};
+            game.Stop();
+            EXPECT_LT(std::chrono::steady_clock::now() - begin,
+                      std::chrono::seconds {1});
+            EXPECT_TRUE(game.IsOver());
+            EXPECT_EQ(game.GetPieceCount(), 2);
+            EXPECT_EQ(scheduler->GetGameCount(), 0);
+
+            // Actions posted to a stopped game are discarded by the next start.
+            game.Post(Action::HardDrop);
+        }
+    }
+}
+
+TEST(GameTest, PostWhileRestarting) {
+    constexpr std::size_t width {10};
+    constexpr std::size_t height {15};
+    const auto scheduler {std::make_shared<GravityScheduler>(1)};
+    for (const auto& shared : {scheduler, std::shared_ptr<GravityScheduler> {}}) {
+        GameSettings settings;
+        settings.SetDescendTime(std::chrono::milliseconds {1})
+            .SetScheduler(shared);
+        Game game {std::make_shared<Grid>(width, height), settings};
+        game.SetActionListener([](std::size_t, Action) {});
+
+        // Another thread posts actions while the game starts and stops.
+        std::jthread producer {[&game](const std::stop_token token) {
+            while (!token.stop_requested()) {
+                game.Post(Action::MoveToLeft);
+                game.Post(Action::RotateRight);
+                game.SetDescendTime(std::chrono::milliseconds {1});
+            }
+        }};
+
+        for (std::size_t round {0}; round < 50; ++round) {
+            game.Start();
+            game.SetActionListener([](std::size_t, Action) {});
+            game.Stop();
+            EXPECT_TRUE(game.IsOver());
+        }
+
+        producer.request_stop();
+        producer.join();
+        EXPECT_EQ(scheduler->GetGameCount(), 0);
+    }
+}
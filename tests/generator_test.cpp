@@ -0,0 +1,70 @@
+#include "generator.h"
+
+#include <gtest/gtest.h>
+
+#include <array>
+
+using namespace testing;
+
+
+namespace {
+
+//! Generate tetromino types through a queue.
+std::vector<tetromino::Type> Generate(PieceGenerator& generator,
+                                      const std::size_t count) {
+    PieceQueue queue;
+    std::vector<tetromino::Type> types;
+    while (types.size() < count) {
+        queue.Fill(generator, 1);
+        types.push_back(queue.Pop().GetType());
+    }
+
+    return types;
+}
+
+}  // namespace
+
+
+TEST(GeneratorTest, Bag) {
+    for (const auto& [randomizer, copies] :
+         {std::pair {Randomizer::Bag7, 1}, std::pair {Randomizer::Bag14, 2}}) {
+        const auto generator {CreateGenerator(randomizer, 1)};
+        const auto bag_size {tetromino::type_count * copies};
+        const auto types {Generate(*generator, bag_size * 20)};
+        for (std::size_t bag {0}; bag < types.size(); bag += bag_size) {
+            std::array<std::size_t, tetromino::type_count> counts {};
+            for (std::size_t i {bag}; i < bag + bag_size; ++i) {
+                ++counts[static_cast<std::size_t>(types[i])];
+            }
+
+            for (const auto count : counts) {
+                EXPECT_EQ(count, copies);
+            }
+        }
+    }
+}
+
+TEST(GeneratorTest, Seed) {
+    for (const auto randomizer : {Randomizer::Uniform, Randomizer::Bag7,
+                                  Randomizer::Bag14, Randomizer::History}) {
+        const auto generator1 {CreateGenerator(randomizer, 9)};
+        const auto generator2 {CreateGenerator(randomizer, 9)};
+        EXPECT_EQ(Generate(*generator1, 100), Generate(*generator2, 100));
+    }
+}
+
+TEST(GeneratorTest, Queue) {
+    const auto generator {CreateGenerator(Randomizer::Uniform, 3)};
+    PieceQueue queue;
+    std::vector<tetromino::Type> popped;
+    // Wrap around the ring several times and check that previews stay in order.
+    for (std::size_t i {0}; i < PieceQueue::capacity * 3; ++i) {
+        queue.Fill(*generator, 10);
+        ASSERT_GE(queue.GetSize(), 10);
+        const auto preview {queue.Peek(10)};
+        const auto front {preview.front().GetType()};
+        const auto second {preview[1].GetType()};
+        EXPECT_EQ(queue.Pop().GetType(), front);
+        EXPECT_EQ(queue.Peek(1).front().GetType(), second);
+    }
+}
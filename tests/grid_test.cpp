@@ -3,6 +3,10 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <random>
+#include <vector>
+
 using namespace testing;
 
 
@@ -187,4 +191,387 @@ TEST(GridTest, ClearLines) {
     */
     EXPECT_FALSE(grid.TetrominoDescend(cleared_line_count));
     EXPECT_EQ(cleared_line_count, 2);
-}
\ No newline at end of file
+}
+
+TEST(GridTest, ClearWideLines) {
+    // The rows of a grid wider than a machine word span several words.
+    constexpr std::size_t width {66};
+    constexpr std::size_t height {4};
+    Grid grid(width, height);
+
+    for (std::size_t x {0}; x < width; x += 2) {
+        ASSERT_TRUE(
+            grid.PushTetromino(std::make_unique<tetromino::O>(), Point {x, 0}));
+
+        std::size_t cleared_line_count {0};
+        while (grid.TetrominoDescend(cleared_line_count)) {
+        }
+
+        EXPECT_EQ(cleared_line_count, x + 2 == width ? 2 : 0);
+    }
+
+    for (std::size_t x {0}; x < width; ++x) {
+        for (std::size_t y {0}; y < height; ++y) {
+            EXPECT_FALSE(grid.Filled({x, y}));
+        }
+    }
+}
+
+TEST(GridTest, CanPlace) {
+    constexpr std::size_t width {4};
+    constexpr std::size_t height {4};
+    Grid grid(width, height);
+
+    EXPECT_TRUE(grid.CanPlace(tetromino::Type::I, Angle::Degree90, {0, 3}));
+    EXPECT_FALSE(grid.CanPlace(tetromino::Type::I, Angle::Degree90, {1, 3}));
+    EXPECT_FALSE(grid.CanPlace(tetromino::Type::I, Angle::Degree0, {0, 1}));
+
+    /*
+        . . . .
+        . . . .
+        O O . .
+        O O . .
+    */
+    ASSERT_TRUE(
+        grid.PushTetromino(std::make_unique<tetromino::O>(), Point {0, 2}));
+    std::size_t cleared_line_count {0};
+    ASSERT_FALSE(grid.TetrominoDescend(cleared_line_count));
+
+    EXPECT_FALSE(grid.CanPlace(tetromino::Type::T, Angle::Degree0, {0, 1}));
+    EXPECT_TRUE(grid.CanPlace(tetromino::Type::T, Angle::Degree0, {0, 0}));
+    EXPECT_TRUE(grid.CanPlace(tetromino::Type::S, Angle::Degree90, {2, 1}));
+}
+
+TEST(GridTest, DropPosition) {
+    constexpr std::size_t width {10};
+    constexpr std::size_t height {20};
+    Grid grid(width, height);
+
+    /*
+        . . . . . . . . . .
+        ...
+        . I I I I . . . . .
+        . . . . I . . . . .
+        . . . . I . . . . .
+        . . . . I . . . . .
+        . . . . I . . . . .
+    */
+    std::size_t cleared_line_count {0};
+    ASSERT_TRUE(grid.PushTetromino(Piece {tetromino::Type::I, Angle::Degree0},
+                                   Point {4, 0}));
+    grid.TetrominoHardDrop(cleared_line_count);
+    ASSERT_TRUE(grid.PushTetromino(Piece {tetromino::Type::I, Angle::Degree90},
+                                   Point {1, 0}));
+    EXPECT_EQ(grid.GetDropPosition(), Point(1, height - 5));
+    grid.TetrominoHardDrop(cleared_line_count);
+    EXPECT_EQ(grid.GetDropPosition(tetromino::Type::O, Angle::Degree0, {0, 0}),
+              Point(0, height - 7));
+
+    // Under an overhang, a tetromino falls through to the floor.
+    EXPECT_EQ(grid.GetDropPosition(tetromino::Type::O, Angle::Degree0,
+                                   {1, height - 4}),
+              Point(1, height - 2));
+
+    // The drop position must match a descent row by row, including after line clears.
+    std::mt19937 eng {0};
+    grid.Reset();
+    for (std::size_t i {0}; i < 1000; ++i) {
+        const auto type {static_cast<tetromino::Type>(
+            std::uniform_int_distribution<int> {0, 6}(eng))};
+        const auto angle {
+            static_cast<Angle>(std::uniform_int_distribution<int> {0, 3}(eng))};
+        const auto& mask {tetromino::GetShapeMask(type, angle)};
+        const Point pos {std::uniform_int_distribution<std::size_t> {
+                             0, width - mask.width}(eng),
+                         std::uniform_int_distribution<std::size_t> {
+                             0, height - mask.height}(eng)};
+        if (!grid.CanPlace(type, angle, pos)) {
+            continue;
+        }
+
+        auto expected {pos};
+        while (grid.CanPlace(type, angle, {expected.x, expected.y + 1})) {
+            ++expected.y;
+        }
+
+        ASSERT_EQ(grid.GetDropPosition(type, angle, pos), expected);
+        ASSERT_TRUE(grid.PushTetromino(Piece {type, angle}, pos));
+        ASSERT_EQ(grid.GetDropPosition(), expected);
+        grid.TetrominoHardDrop(cleared_line_count);
+        EXPECT_FALSE(grid.GetTetromino().has_value());
+    }
+}
+
+TEST(GridTest, ClearLinesAgainstModel) {
+    // Fixing and clearing must match a naive model, including full lines split by incomplete ones.
+    constexpr std::size_t width {6};
+    constexpr std::size_t height {12};
+    Grid grid(width, height);
+    std::vector<std::vector<bool>> model(height, std::vector<bool>(width));
+
+    std::mt19937 eng {1};
+    std::size_t total_cleared_line_count {0};
+    for (std::size_t i {0}; i < 5000; ++i) {
+        const auto type {static_cast<tetromino::Type>(
+            std::uniform_int_distribution<int> {0, 6}(eng))};
+        const auto angle {
+            static_cast<Angle>(std::uniform_int_distribution<int> {0, 3}(eng))};
+        const auto& mask {tetromino::GetShapeMask(type, angle)};
+        const Point pos {std::uniform_int_distribution<std::size_t> {
+                             0, width - mask.width}(eng),
+                         0};
+        if (!grid.PushTetromino(Piece {type, angle}, pos)) {
+            grid.Reset();
+            model.assign(height, std::vector<bool>(width));
+            continue;
+        }
+
+        const auto drop_pos {grid.GetDropPosition()};
+        for (const auto& cell : mask.cells) {
+            model[drop_pos.y + cell.y][drop_pos.x + cell.x] = true;
+        }
+
+        std::erase_if(model, [](const std::vector<bool>& row) {
+            return std::ranges::all_of(row, [](const bool cell) { return cell; });
+        });
+        const auto cleared_line_count {height - model.size()};
+        model.insert(model.begin(), cleared_line_count,
+                     std::vector<bool>(width));
+
+        std::size_t cleared {0};
+        grid.TetrominoHardDrop(cleared);
+        ASSERT_EQ(cleared, cleared_line_count);
+        total_cleared_line_count += cleared;
+        for (std::size_t y {0}; y < height; ++y) {
+            for (std::size_t x {0}; x < width; ++x) {
+                ASSERT_EQ(grid.Filled({x, y}), model[y][x]);
+            }
+        }
+    }
+
+    EXPECT_GT(total_cleared_line_count, 0);
+}
+
+TEST(GridTest, GetPlacements) {
+    constexpr std::size_t width {10};
+    constexpr std::size_t height {20};
+    Grid grid(width, height);
+
+    // On an empty grid, each distinct layout lands once in each column it fits.
+    const auto count_placements {[&](const tetromino::Type type) {
+        return grid.GetPlacements(type, Angle::Degree0, {0, 0}).size();
+    }};
+    EXPECT_EQ(count_placements(tetromino::Type::O), 9);
+    EXPECT_EQ(count_placements(tetromino::Type::I), 7 + 10);
+    EXPECT_EQ(count_placements(tetromino::Type::S), 8 + 9);
+    EXPECT_EQ(count_placements(tetromino::Type::T), 8 + 9 + 8 + 9);
+
+    /*
+        . . . . . . . . . .
+        ...
+        . . . . . . . . . .
+        . I I I I . . . . .
+        . . . . I . . . . .
+        . . . . I . . . . .
+        . . . . I . . . . .
+        . . . . I . . . . .
+    */
+    std::size_t cleared_line_count {0};
+    ASSERT_TRUE(grid.PushTetromino(Piece {tetromino::Type::I, Angle::Degree0},
+                                   Point {4, 0}));
+    grid.TetrominoHardDrop(cleared_line_count);
+    ASSERT_TRUE(grid.PushTetromino(Piece {tetromino::Type::I, Angle::Degree90},
+                                   Point {1, 0}));
+    grid.TetrominoHardDrop(cleared_line_count);
+
+    // A vertical I tetromino can slide under the overhang from the first column.
+    ASSERT_TRUE(grid.PushTetromino(Piece {tetromino::Type::I, Angle::Degree0},
+                                   Point {0, 0}));
+    const auto placements {grid.GetPlacements()};
+    for (std::size_t x {1}; x < 4; ++x) {
+        EXPECT_NE(std::ranges::find(placements,
+                                    Placement {Angle::Degree0, {x, height - 4}}),
+                  placements.end());
+    }
+
+    for (const auto& placement : placements) {
+        EXPECT_LT(static_cast<std::size_t>(placement.angle), 2);
+        EXPECT_TRUE(grid.CanPlace(tetromino::Type::I, placement.angle,
+                                  placement.pos));
+        EXPECT_FALSE(grid.CanPlace(tetromino::Type::I, placement.angle,
+                                   {placement.pos.x, placement.pos.y + 1}));
+    }
+
+    // The grid is not changed.
+    EXPECT_EQ(grid.GetTetromino()->GetPosition(), Point(0, 0));
+    EXPECT_TRUE(grid.GetPlacements(tetromino::Type::O, Angle::Degree0,
+                                   {4, height - 1})
+                    .empty());
+}
+
+TEST(GridTest, SnapshotAndFork) {
+    constexpr std::size_t width {4};
+    constexpr std::size_t height {4};
+    Grid grid(width, height);
+    std::size_t cleared_line_count {0};
+    ASSERT_TRUE(grid.PushTetromino(Piece {tetromino::Type::O}, Point {0, 0}));
+    grid.TetrominoHardDrop(cleared_line_count);
+    ASSERT_TRUE(grid.PushTetromino(Piece {tetromino::Type::O}, Point {2, 0}));
+
+    const auto snapshot {grid.Snapshot()};
+    auto fork {grid.Fork()};
+    auto copy {grid};
+
+    // A fork changes its own board only.
+    fork.TetrominoHardDrop(cleared_line_count);
+    EXPECT_EQ(cleared_line_count, 2);
+    for (std::size_t y {0}; y < height; ++y) {
+        for (std::size_t x {0}; x < width; ++x) {
+            EXPECT_FALSE(fork.Filled({x, y}));
+        }
+    }
+
+    EXPECT_TRUE(grid.Filled({0, height - 1}));
+    EXPECT_TRUE(grid.Filled({2, 0}));
+    EXPECT_FALSE(grid.Filled({2, height - 1}));
+    EXPECT_EQ(grid.GetDropPosition(), Point(2, height - 2));
+
+    // Restoring a snapshot undoes every later change.
+    grid.TetrominoHardDrop(cleared_line_count);
+    grid.Reset();
+    ASSERT_TRUE(grid.PushTetromino(Piece {tetromino::Type::I}, Point {3, 0}));
+    grid.Restore(snapshot);
+    for (std::size_t y {0}; y < height; ++y) {
+        for (std::size_t x {0}; x < width; ++x) {
+            EXPECT_EQ(grid.Filled({x, y}), copy.Filled({x, y}));
+            EXPECT_EQ(grid.GetColor({x, y}), copy.GetColor({x, y}));
+        }
+    }
+
+    ASSERT_TRUE(grid.GetTetromino().has_value());
+    EXPECT_EQ(grid.GetTetromino()->GetPosition(), Point(2, 0));
+    grid.TetrominoHardDrop(cleared_line_count);
+    EXPECT_EQ(cleared_line_count, 2);
+
+    // The snapshot can be restored again.
+    grid.Restore(snapshot);
+    EXPECT_TRUE(grid.Filled({0, height - 1}));
+}
+
+TEST(GridTest, Hash) {
+    // Cover rows of two words.
+    constexpr std::size_t width {68};
+    constexpr std::size_t height {12};
+    Grid grid(width, height);
+    EXPECT_EQ(grid.GetHash(), 0);
+
+    // The incremental hash must always be the XOR of the keys of filled cells, including after clearing lines.
+    const auto hash_cells {[&] {
+        std::uint64_t hash {0};
+        for (std::size_t y {0}; y < height; ++y) {
+            for (std::size_t x {0}; x < width; ++x) {
+                if (grid.Filled({x, y})) {
+                    hash ^= Grid::GetCellKey({x, y});
+                }
+            }
+        }
+
+        return hash;
+    }};
+
+    std::mt19937 eng {3};
+    std::size_t total_cleared_line_count {0};
+    std::size_t next_x {0};
+    for (std::size_t i {0}; i < 3000; ++i) {
+        // Mostly lay horizontal I tetrominoes side by side in order to fill lines.
+        auto type {tetromino::Type::I};
+        auto angle {Angle::Degree90};
+        Point pos {next_x, 0};
+        if (i % 5 == 0) {
+            type = static_cast<tetromino::Type>(
+                std::uniform_int_distribution<int> {0, 6}(eng));
+            angle = static_cast<Angle>(
+                std::uniform_int_distribution<int> {0, 3}(eng));
+            pos.x = std::uniform_int_distribution<std::size_t> {
+                0, width - tetromino::GetShapeMask(type, angle).width}(eng);
+        } else {
+            next_x = (next_x + tetromino::max_size) % width;
+        }
+
+        if (!grid.PushTetromino(Piece {type, angle}, pos)) {
+            grid.Reset();
+            ASSERT_EQ(grid.GetHash(), 0);
+            continue;
+        }
+
+        std::size_t cleared_line_count {0};
+        grid.TetrominoHardDrop(cleared_line_count);
+        total_cleared_line_count += cleared_line_count;
+        ASSERT_EQ(grid.GetHash(), hash_cells());
+    }
+
+    EXPECT_GT(total_cleared_line_count, 0);
+
+    // The same board has the same hash regardless of the order of tetrominoes.
+    Grid first(width, height), second(width, height);
+    std::size_t cleared_line_count {0};
+    ASSERT_TRUE(first.PushTetromino(Piece {tetromino::Type::O}, Point {0, 0}));
+    first.TetrominoHardDrop(cleared_line_count);
+    ASSERT_TRUE(first.PushTetromino(Piece {tetromino::Type::O}, Point {4, 0}));
+    first.TetrominoHardDrop(cleared_line_count);
+    ASSERT_TRUE(second.PushTetromino(Piece {tetromino::Type::O}, Point {4, 0}));
+    second.TetrominoHardDrop(cleared_line_count);
+    const auto snapshot {second.Snapshot()};
+    ASSERT_TRUE(second.PushTetromino(Piece {tetromino::Type::O}, Point {0, 0}));
+    second.TetrominoHardDrop(cleared_line_count);
+    EXPECT_EQ(first.GetHash(), second.GetHash());
+
+    // Restoring a snapshot restores its hash.
+    second.Restore(snapshot);
+    EXPECT_NE(first.GetHash(), second.GetHash());
+}
+
+TEST(GridTest, DirtyRows) {
+    constexpr std::size_t width {4};
+    constexpr std::size_t height {6};
+    Grid grid(width, height);
+    auto frame {grid.Fork()};
+    EXPECT_EQ(grid.GetDirtyRows(frame), std::vector<bool>(height, false));
+
+    // Pushing a tetromino.
+    ASSERT_TRUE(grid.PushTetromino(Piece {tetromino::Type::O}, Point {0, 0}));
+    EXPECT_EQ(grid.GetDirtyRows(frame),
+              (std::vector<bool> {true, true, false, false, false, false}));
+
+    // Moving a tetromino marks the rows it has left and entered.
+    frame = grid.Fork();
+    ASSERT_TRUE(grid.MoveTetrominoToRight());
+    EXPECT_EQ(grid.GetDirtyRows(frame),
+              (std::vector<bool> {true, true, false, false, false, false}));
+
+    // Nothing is dirty after moving back.
+    ASSERT_TRUE(grid.MoveTetrominoToLeft());
+    EXPECT_EQ(grid.GetDirtyRows(frame), std::vector<bool>(height, false));
+
+    frame = grid.Fork();
+    std::size_t cleared_line_count {0};
+    ASSERT_TRUE(grid.TetrominoDescend(cleared_line_count));
+    EXPECT_EQ(grid.GetDirtyRows(frame),
+              (std::vector<bool> {true, true, true, false, false, false}));
+
+    // Fixing a tetromino.
+    frame = grid.Fork();
+    grid.TetrominoHardDrop(cleared_line_count);
+    EXPECT_EQ(cleared_line_count, 0);
+    EXPECT_EQ(grid.GetDirtyRows(frame),
+              (std::vector<bool> {false, true, true, false, true, true}));
+
+    // Clearing lines.
+    ASSERT_TRUE(grid.PushTetromino(Piece {tetromino::Type::O}, Point {2, 0}));
+    frame = grid.Fork();
+    EXPECT_EQ(grid.GetDirtyRows(frame), std::vector<bool>(height, false));
+    grid.TetrominoHardDrop(cleared_line_count);
+    EXPECT_EQ(cleared_line_count, 2);
+    EXPECT_EQ(grid.GetDirtyRows(frame),
+              (std::vector<bool> {true, true, false, false, true, true}));
+}
@@ -0,0 +1,79 @@
+#include "latency.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <random>
+
+using namespace testing;
+
+
+TEST(LatencyTest, Percentile) {
+    using Duration = LatencyHistogram::Duration;
+    LatencyHistogram histogram;
+    EXPECT_EQ(histogram.GetCount(), 0);
+    EXPECT_EQ(histogram.GetPercentile(50), Duration::zero());
+
+    // Small values are counted exactly.
+    for (std::int64_t i {1}; i <= 100; ++i) {
+        histogram.Record(Duration {i});
+    }
+
+    EXPECT_EQ(histogram.GetCount(), 100);
+    EXPECT_EQ(histogram.GetMin(), Duration {1});
+    EXPECT_EQ(histogram.GetMax(), Duration {100});
+    EXPECT_EQ(histogram.GetPercentile(50), Duration {50});
+    EXPECT_EQ(histogram.GetPercentile(99), Duration {99});
+    EXPECT_EQ(histogram.GetPercentile(100), Duration {100});
+
+    // Large values are within the relative error.
+    histogram.Clear();
+    EXPECT_EQ(histogram.GetCount(), 0);
+    constexpr std::int64_t count {100000};
+    for (std::int64_t i {1}; i <= count; ++i) {
+        histogram.Record(std::chrono::microseconds {i});
+    }
+
+    constexpr auto max_error {
+        1.0 / (std::uint64_t {1} << (LatencyHistogram::sub_bucket_bits - 1))};
+    for (const auto percentile : {50.0, 90.0, 99.0, 99.9}) {
+        const auto expected {static_cast<double>(
+            Duration {std::chrono::microseconds {static_cast<std::int64_t>(
+                          percentile / 100 * count)}}
+                .count())};
+        const auto actual {
+            static_cast<double>(histogram.GetPercentile(percentile).count())};
+        EXPECT_GE(actual, expected);
+        EXPECT_LE(actual, expected * (1 + max_error));
+    }
+
+    EXPECT_EQ(histogram.GetPercentile(100),
+              Duration {std::chrono::microseconds {count}});
+}
+
+TEST(LatencyTest, Merge) {
+    using Duration = LatencyHistogram::Duration;
+    std::mt19937_64 random {0};
+    std::uniform_int_distribution<std::int64_t> dist {0, 1'000'000'000};
+    LatencyHistogram all, first, second;
+    for (std::size_t i {0}; i < 10000; ++i) {
+        const Duration time {dist(random)};
+        all.Record(time);
+        (i % 2 == 0 ? first : second).Record(time);
+    }
+
+    first.Merge(second);
+    EXPECT_EQ(first.GetCount(), all.GetCount());
+    EXPECT_EQ(first.GetMin(), all.GetMin());
+    EXPECT_EQ(first.GetMax(), all.GetMax());
+    for (const auto percentile : {0.0, 50.0, 99.0, 99.9, 100.0}) {
+        EXPECT_EQ(first.GetPercentile(percentile),
+                  all.GetPercentile(percentile));
+    }
+
+    // Negative durations are recorded as zero.
+    LatencyHistogram histogram;
+    histogram.Record(Duration {-1});
+    EXPECT_EQ(histogram.GetMax(), Duration::zero());
+}
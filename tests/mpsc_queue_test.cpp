@@ -0,0 +1,62 @@
+#include "mpsc_queue.h"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+using namespace testing;
+
+
+TEST(MpscQueueTest, PushAndPop) {
+    constexpr std::size_t capacity {4};
+    MpscQueue<int, capacity> queue;
+    EXPECT_FALSE(queue.TryPop().has_value());
+
+    // Values are popped in order across several rounds of the cells.
+    for (int round {0}; round < 3; ++round) {
+        for (std::size_t i {0}; i < capacity; ++i) {
+            ASSERT_TRUE(queue.TryPush(round * 10 + static_cast<int>(i)));
+        }
+
+        EXPECT_FALSE(queue.TryPush(-1));
+        for (std::size_t i {0}; i < capacity; ++i) {
+            EXPECT_EQ(queue.TryPop(), round * 10 + static_cast<int>(i));
+        }
+
+        EXPECT_FALSE(queue.TryPop().has_value());
+    }
+}
+
+TEST(MpscQueueTest, Concurrent) {
+    constexpr std::size_t producer_count {4};
+    constexpr std::size_t value_count {10000};
+    MpscQueue<std::size_t, 16> queue;
+
+    std::vector<std::jthread> producers;
+    for (std::size_t producer {0}; producer < producer_count; ++producer) {
+        producers.emplace_back([&queue, producer]() {
+            for (std::size_t i {0}; i < value_count; ++i) {
+                while (!queue.TryPush(producer * value_count + i)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    // Each value is popped once, and values from the same producer keep their order.
+    std::vector<std::size_t> next(producer_count, 0);
+    for (std::size_t popped {0}; popped < producer_count * value_count;) {
+        if (const auto value {queue.TryPop()}) {
+            const auto producer {*value / value_count};
+            ASSERT_LT(producer, producer_count);
+            ASSERT_EQ(*value % value_count, next[producer]);
+            ++next[producer];
+            ++popped;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+    EXPECT_FALSE(queue.TryPop().has_value());
+}
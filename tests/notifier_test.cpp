@@ -0,0 +1,65 @@
+#include "notifier.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace testing;
+
+
+TEST(NotifierTest, WaitUntil) {
+    using namespace std::chrono_literals;
+    Notifier notifier;
+    const std::stop_source source;
+
+    // A notification before a wait is not lost, and several ones are merged.
+    notifier.Notify();
+    notifier.Notify();
+    EXPECT_TRUE(notifier.WaitUntil(std::chrono::steady_clock::time_point::max(),
+                                   source.get_token()));
+    EXPECT_FALSE(notifier.WaitUntil(std::chrono::steady_clock::now() + 1ms,
+                                    source.get_token()));
+
+    notifier.Notify();
+    notifier.Reset();
+    EXPECT_FALSE(notifier.WaitUntil(std::chrono::steady_clock::now() + 1ms,
+                                    source.get_token()));
+}
+
+TEST(NotifierTest, Wake) {
+    // Every notification wakes up the waiting thread, however it interleaves with the wait.
+    constexpr std::size_t round_count {10000};
+    Notifier notifier, reply;
+    std::stop_source source;
+    std::atomic_size_t woken_count {0};
+    std::jthread waiter {[&]() {
+        for (std::size_t i {0}; i < round_count; ++i) {
+            if (!notifier.WaitUntil(std::chrono::steady_clock::time_point::max(),
+                                    source.get_token())) {
+                return;
+            }
+
+            woken_count.fetch_add(1);
+            reply.Notify();
+        }
+    }};
+
+    for (std::size_t i {0}; i < round_count; ++i) {
+        notifier.Notify();
+        ASSERT_TRUE(reply.WaitUntil(
+            std::chrono::steady_clock::now() + std::chrono::seconds {5},
+            source.get_token()));
+    }
+
+    EXPECT_EQ(woken_count.load(), round_count);
+
+    // A stop request wakes up a thread waiting without a deadline.
+    std::jthread stopped {[&]() {
+        EXPECT_FALSE(notifier.WaitUntil(
+            std::chrono::steady_clock::time_point::max(), source.get_token()));
+    }};
+
+    source.request_stop();
+}
@@ -0,0 +1,41 @@
+#include "piece.h"
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+using namespace testing;
+
+
+TEST(PieceTest, Copy) {
+    EXPECT_LE(sizeof(Piece), 8);
+
+    const Piece piece {tetromino::Type::T, Angle::Degree90, Color::Red, {3, 5}};
+    Piece copy;
+    std::memcpy(&copy, &piece, sizeof(Piece));
+    EXPECT_EQ(copy.GetType(), tetromino::Type::T);
+    EXPECT_EQ(copy.GetAngle(), Angle::Degree90);
+    EXPECT_EQ(copy.GetColor(), Color::Red);
+    EXPECT_EQ(copy.GetPosition().x, 3);
+    EXPECT_EQ(copy.GetPosition().y, 5);
+}
+
+TEST(PieceTest, Tetromino) {
+    auto piece {Piece::Create(tetromino::Type::L)};
+    EXPECT_NE(piece.GetColor(), Color::Non);
+
+    piece.RotateRight();
+    EXPECT_EQ(piece.GetAngle(), Angle::Degree270);
+
+    const auto tetromino {piece.ToTetromino()};
+    EXPECT_EQ(tetromino->GetType(), piece.GetType());
+    EXPECT_EQ(tetromino->GetAngle(), piece.GetAngle());
+    EXPECT_EQ(tetromino->GetColor(), piece.GetColor());
+    EXPECT_EQ(tetromino->GetWidth(), piece.GetWidth());
+    EXPECT_EQ(tetromino->GetHeight(), piece.GetHeight());
+
+    const auto converted {Piece::From(*tetromino)};
+    EXPECT_EQ(converted.GetType(), piece.GetType());
+    EXPECT_EQ(converted.GetAngle(), piece.GetAngle());
+    EXPECT_EQ(converted.GetColor(), piece.GetColor());
+}
@@ -0,0 +1,89 @@
+#include "policy.h"
+
+#include <gtest/gtest.h>
+
+using namespace testing;
+
+
+TEST(PolicyTest, HeuristicPolicy) {
+    constexpr std::size_t piece_count {200};
+    GameSettings settings;
+    settings.SetHeadless(true).SetSeed(1);
+    Game game {std::make_shared<Grid>(10, 15), std::move(settings)};
+    HeuristicPolicy policy;
+    game.Start();
+
+    // The policy only rotates, moves and drops, so gravity is never needed.
+    std::size_t action_count {0};
+    while (!game.IsOver() && game.GetPieceCount() <= piece_count) {
+        const auto action {policy.Decide(game)};
+        ASSERT_NE(action, Action::Non);
+        ASSERT_NE(game.Act(action), ActionResult::Failed);
+        ASSERT_LT(++action_count, piece_count * 16);
+    }
+
+    // Each tetromino fills 4 cells, so a grid 10 cells wide needs 2.5 tetrominoes per line.
+    EXPECT_FALSE(game.IsOver());
+    EXPECT_GT(game.GetLineCount(), piece_count * 4 / 10 * 9 / 10);
+}
+
+namespace {
+
+//! Play a headless game with a policy until a number of tetrominoes have been placed.
+std::unique_ptr<Game> Play(Policy& policy, const std::size_t piece_count) {
+    GameSettings settings;
+    settings.SetHeadless(true).SetSeed(2).SetNextCount(3);
+    auto game {std::make_unique<Game>(std::make_shared<Grid>(10, 15),
+                                      std::move(settings))};
+    game->Start();
+    while (!game->IsOver() && game->GetPieceCount() <= piece_count) {
+        game->Act(policy.Decide(*game));
+    }
+
+    return game;
+}
+
+}  // namespace
+
+TEST(PolicyTest, BeamSearchPolicy) {
+    constexpr std::size_t piece_count {100};
+    BeamSearchPolicy serial;
+    serial.SetBeamWidth(4);
+    const auto serial_game {Play(serial, piece_count)};
+    EXPECT_FALSE(serial_game->IsOver());
+    EXPECT_GT(serial_game->GetLineCount(), piece_count * 4 / 10 * 9 / 10);
+
+    const auto& stats {serial.GetStats()};
+    EXPECT_EQ(stats.search_count, piece_count);
+    EXPECT_GT(stats.node_count, stats.search_count);
+    EXPECT_EQ(stats.timeout_count, 0);
+
+    // The result does not depend on the number of threads.
+    BeamSearchPolicy parallel {std::make_shared<WorkStealingPool>(4)};
+    parallel.SetBeamWidth(4);
+    const auto parallel_game {Play(parallel, piece_count)};
+    EXPECT_EQ(parallel.GetStats().node_count, stats.node_count);
+    EXPECT_EQ(parallel_game->GetLineCount(), serial_game->GetLineCount());
+    const auto serial_grid {serial_game->GetGrid()};
+    const auto parallel_grid {parallel_game->GetGrid()};
+    for (std::size_t y {0}; y < serial_grid->GetHeight(); ++y) {
+        for (std::size_t x {0}; x < serial_grid->GetWidth(); ++x) {
+            EXPECT_EQ(parallel_grid->Filled({x, y}),
+                      serial_grid->Filled({x, y}));
+        }
+    }
+}
+
+TEST(PolicyTest, BeamSearchDeadline) {
+    constexpr std::size_t piece_count {20};
+    BeamSearchPolicy policy;
+    policy.SetBeamWidth(64).SetDeadline(
+        std::chrono::steady_clock::duration::zero());
+    const auto game {Play(policy, piece_count)};
+
+    // Only the placements of the current tetromino are searched.
+    const auto& stats {policy.GetStats()};
+    EXPECT_GT(game->GetPieceCount(), piece_count);
+    EXPECT_EQ(stats.search_count, piece_count);
+    EXPECT_EQ(stats.timeout_count, stats.search_count);
+}
@@ -0,0 +1,35 @@
+#include "pool.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <vector>
+
+using namespace testing;
+
+
+TEST(PoolTest, ParallelFor) {
+    constexpr std::size_t thread_count {4};
+    constexpr std::size_t task_count {10000};
+    WorkStealingPool pool {thread_count};
+    ASSERT_EQ(pool.GetThreadCount(), thread_count);
+
+    for (std::size_t round {0}; round < 3; ++round) {
+        std::vector<std::atomic<std::size_t>> runs(task_count);
+        std::atomic<bool> valid_worker {true};
+        pool.ParallelFor(task_count,
+                         [&](const std::size_t i, const std::size_t worker) {
+                             runs[i].fetch_add(1);
+                             if (worker >= thread_count) {
+                                 valid_worker = false;
+                             }
+                         });
+
+        EXPECT_TRUE(valid_worker);
+        for (const auto& run : runs) {
+            ASSERT_EQ(run.load(), 1);
+        }
+    }
+
+    pool.ParallelFor(0, [](std::size_t, std::size_t) { FAIL(); });
+}
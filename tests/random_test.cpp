@@ -0,0 +1,29 @@
+#include "random.h"
+
+#include <gtest/gtest.h>
+
+#include <array>
+
+using namespace testing;
+
+
+TEST(RandomTest, Xoshiro256) {
+    Xoshiro256 eng1 {7}, eng2 {7}, eng3 {8};
+    for (std::size_t i {0}; i < 100; ++i) {
+        const auto value {eng1()};
+        EXPECT_EQ(value, eng2());
+        EXPECT_NE(value, eng3());
+    }
+
+    constexpr std::size_t bound {7};
+    std::array<std::size_t, bound> counts {};
+    for (std::size_t i {0}; i < 7000; ++i) {
+        const auto value {eng1.Below(bound)};
+        ASSERT_LT(value, bound);
+        ++counts[value];
+    }
+
+    for (const auto count : counts) {
+        EXPECT_GT(count, 800);
+    }
+}
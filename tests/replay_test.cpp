@@ -0,0 +1,70 @@
+#include "policy.h"
+#include "replay.h"
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+using namespace testing;
+
+
+TEST(ReplayTest, RecordAndPlay) {
+    GameSettings settings;
+    settings.SetHeadless(true)
+        .SetSeed(42)
+        .SetNextCount(3)
+        .SetRandomizer(Randomizer::Bag7);
+    Game game {std::make_shared<Grid>(10, 15), settings};
+    game.Start();
+
+    std::stringstream replay;
+    ReplayRecorder recorder {replay};
+    recorder.Attach(game);
+
+    RandomPolicy policy {7};
+    while (!game.IsOver()) {
+        if (const auto action {policy.Decide(game)}; action != Action::Non) {
+            game.Act(action);
+        } else {
+            game.Tick();
+        }
+    }
+
+    recorder.Finish();
+
+    const auto result {PlayReplay(replay)};
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(result->header.width, 10);
+    EXPECT_EQ(result->header.height, 15);
+    EXPECT_EQ(result->header.seed, 42);
+    EXPECT_EQ(result->header.next_count, 3);
+    EXPECT_EQ(result->header.randomizer, Randomizer::Bag7);
+    EXPECT_EQ(result->recorded.piece_count, game.GetPieceCount());
+    EXPECT_EQ(result->recorded.tick_count, game.GetTickCount());
+    EXPECT_TRUE(result->Matched());
+    EXPECT_TRUE(result->game->IsOver());
+}
+
+TEST(ReplayTest, Malformed) {
+    std::istringstream empty;
+    EXPECT_FALSE(PlayReplay(empty).has_value());
+
+    std::istringstream bad_magic {"ABCD"};
+    EXPECT_FALSE(PlayReplay(bad_magic).has_value());
+
+    GameSettings settings;
+    settings.SetHeadless(true).SetSeed(1);
+    Game game {std::make_shared<Grid>(10, 15), settings};
+    game.Start();
+
+    std::stringstream replay;
+    ReplayRecorder recorder {replay};
+    recorder.Attach(game);
+    game.Act(Action::MoveToLeft);
+    recorder.Finish();
+
+    auto truncated {replay.str()};
+    truncated.pop_back();
+    std::istringstream is {truncated};
+    EXPECT_FALSE(PlayReplay(is).has_value());
+}
@@ -0,0 +1,53 @@
+#include "row_scan.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+using namespace testing;
+using namespace row_scan;
+
+
+TEST(RowScanTest, AllSet) {
+    constexpr Word last_mask {0b111};
+    for (const auto kernel : {Kernel::Portable, Kernel::AVX2}) {
+        if (!IsSupported(kernel)) {
+            continue;
+        }
+
+        // Cover lengths that are not multiples of a vector.
+        for (std::size_t count {1}; count <= 12; ++count) {
+            std::vector<Word> words(count, ~Word {0});
+            words.back() = last_mask;
+            EXPECT_TRUE(AllSet(kernel, words, last_mask)) << kernel;
+
+            for (std::size_t i {0}; i < count; ++i) {
+                auto row {words};
+                row[i] &= ~(Word {1} << (i % 3));
+                EXPECT_FALSE(AllSet(kernel, row, last_mask)) << kernel;
+            }
+        }
+    }
+
+    EXPECT_TRUE(IsSupported(Kernel::Portable));
+    EXPECT_TRUE(IsSupported(GetBestKernel()));
+}
+
+TEST(RowScanTest, AllClear) {
+    for (const auto kernel : {Kernel::Portable, Kernel::AVX2}) {
+        if (!IsSupported(kernel)) {
+            continue;
+        }
+
+        for (std::size_t count {1}; count <= 12; ++count) {
+            const std::vector<Word> words(count, 0);
+            EXPECT_TRUE(AllClear(kernel, words)) << kernel;
+
+            for (std::size_t i {0}; i < count; ++i) {
+                auto row {words};
+                row[i] = Word {1} << 63;
+                EXPECT_FALSE(AllClear(kernel, row)) << kernel;
+            }
+        }
+    }
+}
@@ -0,0 +1,55 @@
+#include "runner.h"
+
+#include <gtest/gtest.h>
+
+using namespace testing;
+
+
+TEST(RunnerTest, Run) {
+    constexpr std::size_t game_count {20};
+    constexpr std::uint64_t first_seed {100};
+    const Runner runner {10, 15, GameSettings {},
+                         [](const std::uint64_t seed) {
+                             return std::make_unique<RandomPolicy>(seed);
+                         }};
+    WorkStealingPool pool {2};
+    const auto result {runner.Run(pool, game_count, first_seed)};
+    ASSERT_EQ(result.games.size(), game_count);
+
+    std::size_t piece_count {0}, line_count {0}, tick_count {0};
+    for (std::size_t i {0}; i < game_count; ++i) {
+        const auto& game {result.games[i]};
+        EXPECT_EQ(game.seed, first_seed + i);
+        EXPECT_GT(game.piece_count, 0);
+        piece_count += game.piece_count;
+        line_count += game.line_count;
+        tick_count += game.tick_count;
+    }
+
+    EXPECT_EQ(result.piece_count, piece_count);
+    EXPECT_EQ(result.line_count, line_count);
+    EXPECT_EQ(result.tick_count, tick_count);
+
+    // The same seeds reproduce the same games.
+    const auto replayed {runner.Run(pool, game_count, first_seed)};
+    for (std::size_t i {0}; i < game_count; ++i) {
+        EXPECT_EQ(replayed.games[i].piece_count, result.games[i].piece_count);
+        EXPECT_EQ(replayed.games[i].tick_count, result.games[i].tick_count);
+    }
+}
+
+TEST(RunnerTest, MaxPieceCount) {
+    constexpr std::size_t game_count {4};
+    constexpr std::size_t max_piece_count {20};
+    Runner runner {10, 15, GameSettings {}, [](std::uint64_t) {
+                       return std::make_unique<HeuristicPolicy>();
+                   }};
+    runner.SetMaxPieceCount(max_piece_count);
+    WorkStealingPool pool {2};
+    const auto result {runner.Run(pool, game_count)};
+    ASSERT_EQ(result.games.size(), game_count);
+    for (const auto& game : result.games) {
+        // The count includes the last tetromino, which has not been placed.
+        EXPECT_EQ(game.piece_count, max_piece_count + 1);
+    }
+}
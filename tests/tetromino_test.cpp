@@ -14,4 +14,35 @@ TEST(TetrominoTest, Filled) {
     EXPECT_TRUE(o.Filled({1, 1}));
 
     EXPECT_FALSE(o.Filled({o.GetHeight() + 1, o.GetWidth() + 1}));
-}
\ No newline at end of file
+}
+
+TEST(TetrominoTest, ShapeMask) {
+    /*
+        O O O
+        . O .
+    */
+    const auto& t {tetromino::GetShapeMask(tetromino::Type::T, Angle::Degree0)};
+    EXPECT_EQ(t.width, 3);
+    EXPECT_EQ(t.height, 2);
+    EXPECT_EQ(t.rows[0], 0b111);
+    EXPECT_EQ(t.rows[1], 0b010);
+    EXPECT_TRUE(t.Filled({1, 1}));
+    EXPECT_FALSE(t.Filled({0, 1}));
+
+    // Tetrominoes with two underlying shapes repeat them every 180 degrees.
+    const auto& i0 {tetromino::GetShapeMask(tetromino::Type::I, Angle::Degree0)};
+    const auto& i180 {
+        tetromino::GetShapeMask(tetromino::Type::I, Angle::Degree180)};
+    EXPECT_EQ(i0.rows, i180.rows);
+
+    for (const auto angle :
+         {Angle::Degree0, Angle::Degree90, Angle::Degree180, Angle::Degree270}) {
+        const auto tetromino {tetromino::Create(tetromino::Type::L, angle)};
+        const auto& mask {tetromino->GetShapeMask()};
+        EXPECT_EQ(mask.width, tetromino->GetWidth());
+        EXPECT_EQ(mask.height, tetromino->GetHeight());
+        for (const auto& cell : mask.cells) {
+            EXPECT_TRUE(tetromino->Filled(cell));
+        }
+    }
+}
@@ -0,0 +1,111 @@
+#include "timer_wheel.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <optional>
+#include <random>
+#include <vector>
+
+using namespace testing;
+
+
+TEST(TimerWheelTest, Expire) {
+    using namespace std::chrono_literals;
+    constexpr auto resolution {1ms};
+    constexpr std::size_t timer_count {2000};
+    const auto origin {TimerWheel::Clock::now()};
+    TimerWheel wheel {resolution, origin};
+    EXPECT_FALSE(wheel.GetNextWakeUpTime().has_value());
+
+    // Deadlines spread over all levels, including ones beyond the farthest slot.
+    std::mt19937_64 random {0};
+    std::vector<TimerWheel::Clock::time_point> deadlines(timer_count);
+    std::vector<bool> cancelled(timer_count, false);
+    for (std::size_t id {0}; id < timer_count; ++id) {
+        const auto range {id % 4 == 0 ? 12h : id % 4 == 1 ? 1min : 100ms};
+        deadlines[id] =
+            origin
+            + std::chrono::microseconds {std::uniform_int_distribution<long> {
+                0, std::chrono::microseconds {range}.count()}(random)};
+        wheel.Schedule(id, deadlines[id]);
+    }
+
+    for (std::size_t id {0}; id < timer_count; id += 7) {
+        wheel.Cancel(id);
+        cancelled[id] = true;
+    }
+
+    auto earliest {TimerWheel::Clock::time_point::max()};
+    for (std::size_t id {0}; id < timer_count; ++id) {
+        if (!cancelled[id]) {
+            earliest = std::min(earliest, deadlines[id]);
+        }
+    }
+
+    ASSERT_TRUE(wheel.GetNextWakeUpTime().has_value());
+    EXPECT_LT(*wheel.GetNextWakeUpTime(), earliest + resolution);
+
+    std::vector<std::optional<TimerWheel::Clock::time_point>> expired_at(
+        timer_count);
+    auto last {origin};
+    auto now {origin};
+    while (wheel.GetSize() > 0) {
+        const auto wake_up_time {wheel.GetNextWakeUpTime()};
+        ASSERT_TRUE(wake_up_time.has_value());
+        ASSERT_GT(*wake_up_time, last);
+        // Wake up late by a random delay, as a busy thread would.
+        const std::chrono::microseconds delay {
+            std::uniform_int_distribution<long> {0, 5000}(random)};
+        now = std::max(*wake_up_time, now + delay);
+        auto prev_deadline {origin};
+        wheel.Advance(now, [&](const std::size_t id) {
+            ASSERT_LT(id, timer_count);
+            ASSERT_FALSE(expired_at[id].has_value());
+            expired_at[id] = now;
+            // A timer never expires early or more than one tick late.
+            EXPECT_LE(deadlines[id], now);
+            EXPECT_LT(last, deadlines[id] + resolution);
+            EXPECT_LE(prev_deadline, deadlines[id] + resolution);
+            prev_deadline = deadlines[id];
+        });
+
+        last = now;
+    }
+
+    for (std::size_t id {0}; id < timer_count; ++id) {
+        EXPECT_NE(expired_at[id].has_value(), cancelled[id]);
+    }
+}
+
+TEST(TimerWheelTest, Reschedule) {
+    using namespace std::chrono_literals;
+    constexpr auto period {10ms};
+    const auto origin {TimerWheel::Clock::now()};
+    TimerWheel wheel {1ms, origin};
+
+    // A periodic timer rescheduled from its own expiry at absolute deadlines.
+    std::size_t expire_count {0};
+    auto deadline {origin + period};
+    wheel.Schedule(0, deadline);
+    for (auto now {origin}; now < origin + 1s; now += 3ms) {
+        wheel.Advance(now, [&](const std::size_t id) {
+            EXPECT_EQ(id, 0);
+            EXPECT_LE(deadline, now);
+            ++expire_count;
+            deadline += period;
+            wheel.Schedule(id, deadline);
+        });
+    }
+
+    EXPECT_EQ(expire_count, 1s / period - 1);
+    EXPECT_TRUE(wheel.IsScheduled(0));
+
+    // Rescheduling replaces the old deadline.
+    wheel.Schedule(0, origin + 1h);
+    wheel.Advance(origin + 2s, [](std::size_t) { FAIL(); });
+    wheel.Cancel(0);
+    EXPECT_FALSE(wheel.IsScheduled(0));
+    EXPECT_EQ(wheel.GetSize(), 0);
+}
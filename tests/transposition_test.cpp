@@ -0,0 +1,68 @@
+#include "transposition.h"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+using namespace testing;
+
+
+TEST(TranspositionTest, FindAndInsert) {
+    TranspositionTable table {100};
+    EXPECT_EQ(table.GetCapacity(), 128);
+
+    // An empty table has no entry, even for the hash of an empty grid.
+    EXPECT_FALSE(table.Find(0).has_value());
+    EXPECT_FALSE(table.Find(~std::uint64_t {0}).has_value());
+
+    table.Insert(0, 1.5);
+    table.Insert(1, -2);
+    EXPECT_EQ(table.Find(0), 1.5);
+    EXPECT_EQ(table.Find(1), -2);
+
+    // A hash in the same slot replaces the old entry.
+    table.Insert(table.GetCapacity(), 3);
+    EXPECT_FALSE(table.Find(0).has_value());
+    EXPECT_EQ(table.Find(table.GetCapacity()), 3);
+
+    table.Clear();
+    EXPECT_FALSE(table.Find(1).has_value());
+}
+
+TEST(TranspositionTest, Concurrent) {
+    // Threads write different values for the same hashes and read them back.
+    // A value read for a hash must have been written for that hash.
+    constexpr std::size_t thread_count {4};
+    constexpr std::uint64_t hash_count {64};
+    TranspositionTable table {16};
+    const auto value_of {[](const std::uint64_t hash, const std::size_t thread) {
+        return static_cast<double>(hash * thread_count + thread);
+    }};
+
+    std::vector<std::thread> threads;
+    // Each thread writes its own byte, as bits of a vector of bools would share words.
+    std::vector<char> valid(thread_count, true);
+    for (std::size_t t {0}; t < thread_count; ++t) {
+        threads.emplace_back([&, t] {
+            for (std::size_t i {0}; i < 20000; ++i) {
+                const auto hash {(i * 7 + t) % hash_count};
+                table.Insert(hash, value_of(hash, t));
+                if (const auto value {table.Find((hash + 1) % hash_count)};
+                    value.has_value()
+                    && static_cast<std::uint64_t>(*value) / thread_count
+                           != (hash + 1) % hash_count) {
+                    valid[t] = false;
+                }
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (std::size_t t {0}; t < thread_count; ++t) {
+        EXPECT_TRUE(valid[t]);
+    }
+}